@@ -0,0 +1,202 @@
+#include "demo/broadphase.hpp"
+#include "demo/components.hpp"
+#include "ecs/world.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace game::ecs;
+using namespace game::example;
+
+namespace {
+
+struct Body {
+    Entity entity;
+    float dx;
+    float dy;
+};
+
+struct Scene {
+    const char* name;
+    float large_fraction;  // Share of colliders with a large radius
+    float large_radius;
+    float swarm_extent;    // Side of the central square small colliders crowd into, 0 to spread them out
+};
+
+/**
+ * @brief Fills a world with colliders: mostly small ones plus a share of large ones.
+ */
+std::vector<Body> populate(World& world, const std::size_t count, const float extent, const Scene& scene) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> position(0.0f, extent);
+    const float swarm = scene.swarm_extent > 0.0f ? scene.swarm_extent : extent;
+    std::uniform_real_distribution<float> swarm_position(0.5f * (extent - swarm), 0.5f * (extent + swarm));
+    std::uniform_real_distribution<float> small(0.5f, 4.0f);
+    std::uniform_real_distribution<float> large(scene.large_radius * 0.5f, scene.large_radius);
+    std::uniform_real_distribution<float> share(0.0f, 1.0f);
+    std::uniform_real_distribution<float> speed(-1.0f, 1.0f);
+
+    std::vector<Body> bodies;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto entity = world.add_entity();
+        const bool is_large = share(rng) < scene.large_fraction;
+        const float radius = is_large ? large(rng) : small(rng);
+        auto& place = is_large ? position : swarm_position;
+        world.add_component(entity, Position{place(rng), place(rng)});
+        world.add_component(entity, Collider{radius});
+        bodies.push_back({entity, speed(rng), speed(rng)});
+    }
+    world.publish_double_buffered();
+    return bodies;
+}
+
+void move(World& world, const std::vector<Body>& bodies) {
+    for (const auto& body : bodies) {
+        auto& position = world.get_component<Position>(body.entity);
+        position.x += body.dx;
+        position.y += body.dy;
+    }
+    world.publish_double_buffered();
+}
+
+/**
+ * @brief O(n^2) reference: every pair whose exact bounds overlap.
+ */
+void brute_force(const World& world, const std::vector<Body>& bodies, std::vector<CollisionPair>& pairs) {
+    std::vector<Aabb> boxes;
+    boxes.reserve(bodies.size());
+    for (const auto& body : bodies) {
+        boxes.push_back(Aabb::from_circle(world.get_component<Position>(body.entity),
+                                          world.get_component<Collider>(body.entity)));
+    }
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        for (std::size_t j = i + 1; j < boxes.size(); ++j) {
+            if (boxes[i].overlaps(boxes[j])) {
+                pairs.emplace_back(bodies[i].entity, bodies[j].entity);
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+}
+
+/**
+ * @brief Number of reference pairs the candidate list misses; both must be sorted.
+ */
+std::size_t count_missed(const std::vector<CollisionPair>& reference, const std::vector<CollisionPair>& candidates) {
+    std::vector<CollisionPair> missed;
+    std::set_difference(reference.begin(), reference.end(), candidates.begin(), candidates.end(), std::back_inserter(missed));
+    return missed.size();
+}
+
+struct Result {
+    double ms_per_frame;
+    std::size_t candidates;
+    std::size_t missed;
+};
+
+Result run(Broadphase* broadphase, const Scene& scene, const std::size_t count, const float extent, const int frames) {
+    World world;
+    world.register_component<Position>();
+    world.register_component<Collider>();
+    const auto bodies = populate(world, count, extent, scene);
+    std::vector<Entity> entities;
+    for (const auto& body : bodies) {
+        entities.push_back(body.entity);
+    }
+
+    std::vector<CollisionPair> pairs;
+    std::vector<CollisionPair> reference;
+    double total_ns = 0.0;
+    Result result{0.0, 0, 0};
+    for (int frame = 0; frame < frames; ++frame) {
+        move(world, bodies);
+
+        pairs.clear();
+        const auto start = std::chrono::steady_clock::now();
+        if (broadphase != nullptr) {
+            broadphase->update(world, entities);
+            broadphase->collect_pairs(pairs);
+        } else {
+            brute_force(world, bodies, pairs);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        total_ns += elapsed.count();
+
+        // Every frame is checked against the brute-force pairs of the same positions
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+        reference.clear();
+        brute_force(world, bodies, reference);
+        result.candidates += pairs.size();
+        result.missed += count_missed(reference, pairs);
+    }
+
+    result.ms_per_frame = total_ns / frames / 1e6;
+    result.candidates /= static_cast<std::size_t>(frames);
+    return result;
+}
+
+}
+
+/**
+ * Compares the uniform grid and AABB tree broadphases on mixed collider sizes.
+ *
+ * Usage: broadphase_bench [colliders] [frames]
+ * Defaults to MAX_ENTITIES colliders and 50 frames. Each scene moves
+ * every collider a little per frame; radii are 0.5-4 units, except for a
+ * share of large ones. Small colliders are spread over the world, or in
+ * the swarm scenes crowded into a 160 x 160 square a few grid cells
+ * wide, as bullets around a boss would be. Each broadphase's candidate
+ * pairs are checked against the O(n^2) brute-force overlap list every
+ * frame and must not miss any pair; the brute force itself is timed as
+ * the baseline.
+ */
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::min<std::size_t>(std::strtoull(argv[1], nullptr, 10), MAX_ENTITIES) : MAX_ENTITIES;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 50;
+    const auto extent = static_cast<float>(std::sqrt(static_cast<double>(count) * 80.0));
+
+    const Scene scenes[] = {
+        {"uniform small", 0.0f, 0.0f, 0.0f},
+        {"1% large (r 100)", 0.01f, 100.0f, 0.0f},
+        {"5% large (r 100)", 0.05f, 100.0f, 0.0f},
+        {"1% huge (r 400)", 0.01f, 400.0f, 0.0f},
+        {"swarm + 1% r 100", 0.01f, 100.0f, 160.0f},
+        {"swarm + 1% r 400", 0.01f, 400.0f, 160.0f},
+    };
+
+    std::cout << "=== Broadphase benchmark ===\n"
+              << count << " colliders over " << extent << " x " << extent << ", " << frames << " frames\n\n"
+              << std::fixed << std::setprecision(3) << std::setw(20) << "" << std::setw(16) << "broadphase"
+              << std::setw(12) << "ms/frame" << std::setw(10) << "speedup" << std::setw(12) << "candidates"
+              << std::setw(10) << "missed" << "\n";
+
+    bool complete = true;
+    for (const auto& scene : scenes) {
+        const auto reference = run(nullptr, scene, count, extent, frames);
+        std::cout << std::setw(20) << scene.name << std::setw(16) << "brute force" << std::setw(12) << reference.ms_per_frame
+                  << std::setw(10) << "1.00x" << std::setw(12) << reference.candidates << std::setw(10) << "-" << "\n";
+
+        UniformGridBroadphase grid;
+        AabbTreeBroadphase tree;
+        const std::pair<const char*, Broadphase*> broadphases[] = {{"uniform grid", &grid}, {"aabb tree", &tree}};
+        for (const auto& [name, broadphase] : broadphases) {
+            const auto result = run(broadphase, scene, count, extent, frames);
+            complete = complete && result.missed == 0;
+            std::cout << std::setw(20) << "" << std::setw(16) << name << std::setw(12) << result.ms_per_frame
+                      << std::setw(9) << std::setprecision(2) << reference.ms_per_frame / result.ms_per_frame << "x"
+                      << std::setprecision(3) << std::setw(12) << result.candidates << std::setw(10) << result.missed << "\n";
+        }
+    }
+
+    std::cout << "\nall overlapping pairs found: " << (complete ? "yes" : "NO") << "\n";
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+#include "ecs/cold_storage_array.hpp"
+#include "ecs/entity.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace game::ecs;
+
+namespace {
+
+volatile std::uint64_t sink = 0;
+
+/**
+ * @brief AI blackboard of a dormant NPC: mostly defaults, a few per-entity values.
+ */
+struct AiState {
+    float patrol_range;
+    float detection_radius;
+    float home_x, home_y;
+    float aggression;
+    std::uint32_t behaviour;
+    std::uint32_t waypoint;
+    std::uint32_t flags;
+    Entity target;
+    std::uint64_t last_seen_tick;
+    float cooldowns[4];
+};
+
+using Pool = ColdStorageArray<AiState>;
+
+/**
+ * @brief Resident set size of the process in bytes.
+ */
+std::size_t resident_bytes() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    statm >> size >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::size_t page_bytes(const std::vector<std::unique_ptr<Pool>>& pools) {
+    std::size_t bytes = 0;
+    for (const auto& pool : pools) {
+        bytes += pool->page_bytes();
+    }
+    return bytes;
+}
+
+template<typename F>
+double elapsed_ns(F&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief Reads one component from every page of every pool.
+ */
+void touch_every_page(const std::vector<std::unique_ptr<Pool>>& pools) {
+    std::uint64_t sum = 0;
+    for (const auto& pool : pools) {
+        for (std::size_t index = 0; index < pool->size(); index += Pool::PAGE_SIZE) {
+            sum += std::as_const(*pool).at(index).waypoint;
+        }
+    }
+    sink = sink + sum;
+}
+
+}
+
+/**
+ * Measures memory saved by cold storage and the cost of the first access.
+ *
+ * Usage: cold_bench [pools]
+ * Fills the given number of ColdStorageArray pools (default 200, one per
+ * world shard) with MAX_ENTITIES dormant AI states each, compresses every
+ * page, then reads one component per page twice: the first read
+ * decompresses the page, the second hits it hot. RSS is read from
+ * /proc/self/statm after returning freed memory to the OS.
+ */
+int main(int argc, char** argv) {
+    const std::size_t pool_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+
+    const auto baseline = resident_bytes();
+    std::vector<std::unique_ptr<Pool>> pools;
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> coordinate(0.0f, 4096.0f);
+    std::uniform_int_distribution<std::uint32_t> small(0, 3);
+    for (std::size_t i = 0; i < pool_count; ++i) {
+        auto pool = std::make_unique<Pool>();
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            pool->insert(entity, AiState{200.0f, 150.0f, coordinate(rng), coordinate(rng), 0.25f * static_cast<float>(small(rng)),
+                                         small(rng), small(rng), 0, INVALID_ENTITY, 1200, {0.0f, 0.0f, 0.0f, 0.0f}});
+        }
+        pools.push_back(std::move(pool));
+    }
+
+    const auto hot_pages = page_bytes(pools);
+    const auto hot_rss = resident_bytes() - baseline;
+
+    std::size_t compressed = 0;
+    const auto compress_ns = elapsed_ns([&] {
+        for (const auto& pool : pools) {
+            pool->set_idle_ticks(0);
+            compressed += pool->compress_idle();
+        }
+    });
+    const auto cold_pages = page_bytes(pools);
+    const auto cold_rss = resident_bytes() - baseline;
+
+    const auto page_count = static_cast<double>(compressed);
+    const auto thaw_ns = elapsed_ns([&] { touch_every_page(pools); }) / page_count;
+    const auto hot_ns = elapsed_ns([&] { touch_every_page(pools); }) / page_count;
+
+    constexpr double MB = 1024.0 * 1024.0;
+    std::cout << "=== Cold storage benchmark ===\n"
+              << pool_count * MAX_ENTITIES << " components of " << sizeof(AiState) << " bytes in " << pool_count
+              << " pools, " << compressed << " pages of " << Pool::PAGE_SIZE << "\n\n" << std::fixed << std::setprecision(1)
+              << std::setw(16) << "" << std::setw(14) << "page MB" << std::setw(14) << "RSS MB" << "\n"
+              << std::setw(16) << "hot" << std::setw(14) << hot_pages / MB << std::setw(14) << hot_rss / MB << "\n"
+              << std::setw(16) << "compressed" << std::setw(14) << cold_pages / MB << std::setw(14) << cold_rss / MB << "\n"
+              << std::setw(16) << "saved" << std::setw(13) << 100.0 * (1.0 - static_cast<double>(cold_pages) / hot_pages) << "%"
+              << std::setw(13) << 100.0 * (1.0 - static_cast<double>(cold_rss) / hot_rss) << "%\n\n"
+              << "compress    " << std::setw(10) << compress_ns / page_count / 1e3 << " us per page\n"
+              << "first read  " << std::setw(10) << thaw_ns / 1e3 << " us (decompress)\n"
+              << "next read   " << std::setw(10) << std::setprecision(3) << hot_ns / 1e3 << " us\n";
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "demo/narrowphase.hpp"
+#include "demo/parallel_collision.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace game::ecs;
+using namespace game::example;
+
+namespace {
+
+struct Circle {
+    float x;
+    float y;
+    float radius;
+};
+
+std::vector<Circle> make_scene(const std::size_t count, const float extent) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(0.0f, extent);
+    std::uniform_real_distribution<float> radius(0.5f, 3.0f);
+
+    std::vector<Circle> circles(count);
+    for (auto& circle : circles) {
+        circle = {position(rng), position(rng), radius(rng)};
+    }
+    return circles;
+}
+
+/**
+ * @brief ms per frame of CollisionSystem's serial path: uniform grid, sorted pairs, circle narrow phase.
+ */
+double run_serial(const World& world, const std::vector<Entity>& entities, const int frames, std::vector<CollisionPair>& contacts) {
+    UniformGridBroadphase broadphase;
+    CircleNarrowphase narrowphase;
+    std::vector<CollisionPair> pairs;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        pairs.clear();
+        contacts.clear();
+        broadphase.update(world, entities);
+        broadphase.collect_pairs(pairs);
+        std::sort(pairs.begin(), pairs.end());
+        narrowphase.gather(world, entities);
+        narrowphase.find_contacts(pairs, contacts);
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+
+/**
+ * @brief Times BroadphaseKind::ParallelGrid against the serial path on a world of MAX_ENTITIES colliders.
+ * @return False if a thread count finds other contacts than the serial path
+ */
+bool compare_with_serial(const std::size_t max_threads, const int frames) {
+    const auto extent = static_cast<float>(std::sqrt(static_cast<double>(MAX_ENTITIES) * 80.0));
+    const auto scene = make_scene(MAX_ENTITIES, extent);
+
+    World world;
+    world.register_component<Position>();
+    world.register_component<Collider>();
+    std::vector<Entity> entities;
+    for (const auto& circle : scene) {
+        const auto entity = world.add_entity();
+        world.add_component(entity, Position{circle.x, circle.y});
+        world.add_component(entity, Collider{circle.radius});
+        entities.push_back(entity);
+    }
+    world.publish_double_buffered();
+
+    std::vector<CollisionPair> reference;
+    const double serial_ms = run_serial(world, entities, frames, reference);
+
+    std::cout << "\nCollisionSystem, " << MAX_ENTITIES << " colliders, 64-unit cells\n"
+              << std::setw(8) << "threads" << std::setw(14) << "ms/frame" << std::setw(10) << "vs serial"
+              << std::setw(12) << "contacts" << "  inline\n"
+              << std::setw(8) << "serial" << std::setw(14) << serial_ms << std::setw(9) << 1.0 << "x"
+              << std::setw(12) << reference.size() << "\n";
+
+    bool all_match = true;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        JobSystem jobs(threads);
+        ParallelCollisionPipeline pipeline(jobs);
+        std::vector<CollisionPair> contacts;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            contacts.clear();
+            pipeline.gather(world, entities);
+            pipeline.find_contacts(contacts);
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        const double ms = elapsed.count() / frames;
+        all_match = all_match && contacts == reference;
+
+        std::cout << std::setw(8) << threads << std::setw(14) << ms << std::setw(9) << serial_ms / ms << "x"
+                  << std::setw(12) << contacts.size() << "  " << (pipeline.get_worker_count() == 1 ? "yes" : "no")
+                  << (contacts == reference ? "" : "  MISMATCH") << "\n";
+    }
+    return all_match;
+}
+
+}
+
+/**
+ * Measures ParallelCollisionPipeline scaling on a large synthetic scene.
+ *
+ * Usage: collision_bench [colliders] [max_threads] [frames]
+ * Defaults to 200k colliders and 1..16 threads. Each thread count must
+ * produce exactly the contact list of the single-threaded run. A second
+ * table times the pipeline against CollisionSystem's serial grid path on
+ * a world of MAX_ENTITIES colliders, which it must match too. Pipelines
+ * on a single worker or a single hardware thread run inline.
+ */
+int main(int argc, char** argv) {
+    const std::size_t collider_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+    const std::size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    const int frames = argc > 3 ? std::atoi(argv[3]) : 10;
+
+    // Keep density constant: roughly one collider per 80 square units
+    const auto extent = static_cast<float>(std::sqrt(static_cast<double>(collider_count) * 80.0));
+    const auto scene = make_scene(collider_count, extent);
+
+    std::cout << "=== Collision pipeline benchmark ===\n"
+              << collider_count << " colliders, " << frames << " frames per run, "
+              << std::thread::hardware_concurrency() << " hardware threads\n\n"
+              << std::setw(8) << "threads" << std::setw(14) << "ms/frame" << std::setw(10) << "speedup"
+              << std::setw(12) << "contacts" << "  deterministic\n";
+
+    std::vector<CollisionPair> reference;
+    double baseline_ms = 0.0;
+    bool all_match = true;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        JobSystem jobs(threads);
+        ParallelCollisionPipeline pipeline(jobs, 8.0f);
+        std::vector<CollisionPair> contacts;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            pipeline.clear();
+            for (std::size_t i = 0; i < scene.size(); ++i) {
+                pipeline.add_collider(i, scene[i].x, scene[i].y, scene[i].radius);
+            }
+            contacts.clear();
+            pipeline.find_contacts(contacts);
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        const double ms = elapsed.count() / frames;
+
+        if (threads == 1) {
+            reference = contacts;
+            baseline_ms = ms;
+        }
+        const bool matches = contacts == reference;
+        all_match = all_match && matches;
+
+        std::cout << std::setw(8) << threads << std::setw(14) << std::fixed << std::setprecision(2) << ms
+                  << std::setw(9) << baseline_ms / ms << "x" << std::setw(12) << contacts.size()
+                  << "  " << (matches ? "yes" : "NO") << "\n";
+    }
+
+    all_match = compare_with_serial(max_threads, frames * 20) && all_match;
+    return all_match ? 0 : 1;
+}
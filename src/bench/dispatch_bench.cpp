@@ -0,0 +1,120 @@
+#include "ecs/static_system.hpp"
+#include "ecs/system.hpp"
+#include "ecs/world.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+using namespace game::ecs;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float dx, dy;
+};
+
+/**
+ * @brief Movement as a classic System: virtual tick over an entity set.
+ */
+template<int N>
+class VirtualMovement : public System {
+    World* world_;
+
+public:
+    explicit VirtualMovement(World* world) : world_(world) {}
+
+    void tick(const float delta) override {
+        for (const auto entity : entities_) {
+            auto& position = world_->get_component<Position>(entity);
+            const auto& velocity = std::as_const(*world_).get_component<Velocity>(entity);
+            position.x += velocity.dx * delta;
+            position.y += velocity.dy * delta;
+        }
+    }
+};
+
+/**
+ * @brief The same movement as a StaticSystem.
+ */
+template<int N>
+class StaticMovement : public StaticSystem<StaticMovement<N>, Reads<Velocity>, Writes<Position>> {
+public:
+    void update(const float delta, Entity, Position& position, const Velocity& velocity) noexcept {
+        position.x += velocity.dx * delta;
+        position.y += velocity.dy * delta;
+    }
+};
+
+template<int... Ns>
+void register_virtual(World& world, std::integer_sequence<int, Ns...>) {
+    ((void)world.register_system<VirtualMovement<Ns>>(&world), ...);
+    (world.set_system_signature<VirtualMovement<Ns>, Position, Velocity>(), ...);
+}
+
+template<int... Ns>
+auto make_static_group(std::integer_sequence<int, Ns...>) {
+    return StaticSystemGroup<StaticMovement<Ns>...>{StaticMovement<Ns>{}...};
+}
+
+void populate(World& world, const std::size_t entities) {
+    for (std::size_t i = 0; i < entities; ++i) {
+        const auto entity = world.add_entity();
+        world.add_component(entity, Position{static_cast<float>(i), 0.0f});
+        world.add_component(entity, Velocity{1.0f, 2.0f});
+    }
+}
+
+template<typename F>
+double ns_per_frame(const int frames, F&& frame) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        frame();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+
+}
+
+/**
+ * Compares per-frame cost of 8 movement systems dispatched virtually
+ * (System, entity set, get_component() per entity) and statically
+ * (StaticSystemGroup, view iteration) at small entity counts, where
+ * dispatch and per-entity lookups dominate.
+ *
+ * Usage: dispatch_bench [frames]
+ */
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 20000;
+    constexpr auto systems = std::make_integer_sequence<int, 8>{};
+
+    std::cout << "=== System dispatch benchmark ===\n8 movement systems; ns per frame\n\n"
+              << std::setw(10) << "entities" << std::setw(14) << "virtual" << std::setw(14) << "static"
+              << std::setw(10) << "ratio" << "\n" << std::fixed << std::setprecision(1);
+
+    for (const std::size_t entities : {0, 1, 4, 16, 64, 256, 1024}) {
+        World virtual_world;
+        virtual_world.register_component<Position>();
+        virtual_world.register_component<Velocity>();
+        register_virtual(virtual_world, systems);
+        populate(virtual_world, entities);
+
+        World static_world;
+        static_world.register_component<Position>();
+        static_world.register_component<Velocity>();
+        auto group = make_static_group(systems);
+        populate(static_world, entities);
+
+        const auto virtual_ns = ns_per_frame(frames, [&] { virtual_world.tick(0.016f); });
+        const auto static_ns = ns_per_frame(frames, [&] { group.tick(static_world, 0.016f); });
+        std::cout << std::setw(10) << entities << std::setw(14) << virtual_ns << std::setw(14) << static_ns
+                  << std::setw(9) << virtual_ns / static_ns << "x\n";
+    }
+    return 0;
+}
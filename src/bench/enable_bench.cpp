@@ -0,0 +1,180 @@
+#include "ecs/entity_bitset.hpp"
+#include "ecs/system.hpp"
+#include "ecs/world.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace game::ecs;
+
+namespace {
+
+constexpr std::size_t LARGE_COUNT = 1'000'000;
+
+volatile float sink = 0.0f;
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float dx, dy;
+};
+
+template<int N>
+class MovingSystem : public System {
+public:
+    void tick(float) override {}
+};
+
+template<typename F>
+double ns_per_frame(const int frames, F&& frame) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        frame(i);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+
+/**
+ * @brief Picks a tenth of the IDs below count for every frame.
+ */
+std::vector<std::vector<Entity>> make_toggles(const std::size_t count, const int frames) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<Entity> pick(0, count - 1);
+    std::vector<std::vector<Entity>> toggles(static_cast<std::size_t>(frames));
+    for (auto& batch : toggles) {
+        batch.resize(count / 10);
+        for (auto& entity : batch) {
+            entity = pick(rng);
+        }
+    }
+    return toggles;
+}
+
+/**
+ * @brief Toggles and scans a bitset over 1M IDs; no World, whose IDs are capped at MAX_ENTITIES.
+ */
+void bench_large(const int frames) {
+    auto enabled = std::make_unique<EntityBitset<LARGE_COUNT>>();
+    for (Entity entity = 0; entity < LARGE_COUNT; entity += 2) {
+        enabled->set(entity);
+    }
+    std::vector<float> values(LARGE_COUNT, 1.0f);
+    const auto toggles = make_toggles(LARGE_COUNT, frames);
+
+    const auto toggle_ns = ns_per_frame(frames, [&](const int frame) {
+        for (const auto entity : toggles[static_cast<std::size_t>(frame)]) {
+            enabled->assign(entity, !enabled->test(entity));
+        }
+    });
+    const auto scan_ns = ns_per_frame(frames, [&](int) {
+        float sum = 0.0f;
+        enabled->for_each([&](const Entity entity) { sum += values[entity]; });
+        sink = sink + sum;
+    });
+    const auto test_ns = ns_per_frame(frames, [&](int) {
+        float sum = 0.0f;
+        for (Entity entity = 0; entity < LARGE_COUNT; ++entity) {
+            if (enabled->test(entity)) {
+                sum += values[entity];
+            }
+        }
+        sink = sink + sum;
+    });
+
+    std::cout << "1M IDs, 100k toggles per frame\n" << std::fixed << std::setprecision(1)
+              << "  toggle            " << std::setw(10) << toggle_ns / 1e3 << " us/frame ("
+              << toggle_ns / static_cast<double>(LARGE_COUNT / 10) << " ns each)\n"
+              << "  scan, word-wise   " << std::setw(10) << scan_ns / 1e3 << " us/frame\n"
+              << "  scan, bit per ID  " << std::setw(10) << test_ns / 1e3 << " us/frame\n\n";
+}
+
+/**
+ * @brief Pauses a tenth of a full world per frame by disabling vs by removing Velocity.
+ */
+void bench_world(const int frames) {
+    World world;
+    world.register_component<Position>();
+    world.register_component<Velocity>();
+    (void)world.register_system<MovingSystem<0>>();
+    (void)world.register_system<MovingSystem<1>>();
+    (void)world.register_system<MovingSystem<2>>();
+    world.set_system_signature<MovingSystem<0>, Position, Velocity>();
+    world.set_system_signature<MovingSystem<1>, Velocity>();
+    world.set_system_signature<MovingSystem<2>, Position, Velocity>();
+
+    for (std::size_t i = 0; i < MAX_ENTITIES; ++i) {
+        const auto entity = world.add_entity();
+        world.add_component(entity, Position{static_cast<float>(i), 0.0f});
+        world.add_component(entity, Velocity{1.0f, 1.0f});
+    }
+
+    const auto toggles = make_toggles(MAX_ENTITIES, frames);
+    const auto iterate = [&] {
+        float sum = 0.0f;
+        world.view<Velocity, const Position>().each([&](Entity, Velocity& velocity, const Position& position) {
+            sum += velocity.dx * position.x;
+        });
+        sink = sink + sum;
+    };
+
+    const auto disable_ns = ns_per_frame(frames, [&](const int frame) {
+        const auto& batch = toggles[static_cast<std::size_t>(frame)];
+        for (const auto entity : batch) {
+            world.set_entity_enabled(entity, false);
+        }
+        iterate();
+        for (const auto entity : batch) {
+            world.set_entity_enabled(entity, true);
+        }
+    });
+    const auto remove_ns = ns_per_frame(frames, [&](const int frame) {
+        const auto& batch = toggles[static_cast<std::size_t>(frame)];
+        std::vector<Velocity> saved;
+        saved.reserve(batch.size());
+        for (const auto entity : batch) {
+            if (world.has_component<Velocity>(entity)) {
+                saved.push_back(world.get_component<Velocity>(entity));
+                world.remove_component<Velocity>(entity);
+            }
+        }
+        iterate();
+        std::size_t next = 0;
+        for (const auto entity : batch) {
+            if (!world.has_component<Velocity>(entity)) {
+                world.add_component(entity, saved[next++]);
+            }
+        }
+    });
+
+    std::cout << MAX_ENTITIES << "-entity world, 3 systems, pause 10%, iterate, resume\n"
+              << "  disable bit       " << std::setw(10) << disable_ns / 1e3 << " us/frame\n"
+              << "  remove/re-add     " << std::setw(10) << remove_ns / 1e3 << " us/frame\n";
+}
+
+}
+
+/**
+ * Measures pausing entities with the enabled bit.
+ *
+ * Usage: enable_bench [frames]
+ * First toggles 10% of 1M IDs per frame in an EntityBitset and scans the
+ * enabled ones word-wise and bit by bit. Then, in a full World, pauses
+ * 10% of the entities, runs a view and resumes them, once by disabling
+ * them and once by removing and re-adding a component.
+ */
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 100;
+
+    std::cout << "=== Entity enable/disable benchmark ===\n\n";
+    bench_large(frames);
+    bench_world(frames);
+    return 0;
+}
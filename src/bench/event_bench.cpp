@@ -0,0 +1,102 @@
+#include "ecs/event_bus.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace game::ecs;
+
+namespace {
+
+volatile std::uint64_t sink = 0;
+
+struct HitEvent {
+    std::uint64_t attacker;
+    std::uint64_t target;
+    float amount;
+};
+
+struct FrameTimes {
+    double emit_ms{0.0};
+    double swap_ms{0.0};
+    double read_ms{0.0};
+};
+
+/**
+ * @brief Emits events_per_frame events from producers threads, then swaps and reads them.
+ */
+FrameTimes bench_frames(const std::size_t producers, const std::size_t events_per_frame, const int frames) {
+    EventQueue<HitEvent> queue(1024);
+    FrameTimes times;
+
+    // Frame 0 grows the queue to the high-water mark and is not timed
+    for (int frame = -1; frame < frames; ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue, p, producers, events_per_frame] {
+                for (auto i = p * events_per_frame / producers; i < (p + 1) * events_per_frame / producers; ++i) {
+                    queue.emit({i, i + 1, 1.0f});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const auto emitted = std::chrono::steady_clock::now();
+        queue.swap_buffers();
+        const auto swapped = std::chrono::steady_clock::now();
+
+        std::uint64_t sum = 0;
+        for (const auto& event : queue.read()) {
+            sum += event.target;
+        }
+        sink = sink + sum;
+        const auto read = std::chrono::steady_clock::now();
+
+        if (frame >= 0) {
+            times.emit_ms += std::chrono::duration<double, std::milli>(emitted - start).count();
+            times.swap_ms += std::chrono::duration<double, std::milli>(swapped - emitted).count();
+            times.read_ms += std::chrono::duration<double, std::milli>(read - swapped).count();
+        }
+    }
+
+    times.emit_ms /= frames;
+    times.swap_ms /= frames;
+    times.read_ms /= frames;
+    return times;
+}
+
+}
+
+/**
+ * Measures EventQueue throughput at 1M events per frame.
+ *
+ * Usage: event_bench [events_per_frame] [max_producers] [frames]
+ * Producer threads emit their share of the frame's events concurrently,
+ * then the queue is swapped and every event read once. The first frame
+ * grows the queue and is not timed, so later frames stay on the
+ * lock-free path. Emit time includes starting and joining the threads.
+ */
+int main(int argc, char** argv) {
+    const std::size_t events = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t max_producers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+    const int frames = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    std::cout << "=== Event bus benchmark ===\n"
+              << std::thread::hardware_concurrency() << " hardware threads, " << events << " events per frame\n\n"
+              << std::setw(10) << "producers" << std::setw(12) << "emit ms" << std::setw(12) << "swap ms"
+              << std::setw(12) << "read ms" << std::setw(16) << "Mevents/s" << "\n"
+              << std::fixed << std::setprecision(2);
+
+    for (std::size_t producers = 1; producers <= max_producers; producers *= 2) {
+        const auto times = bench_frames(producers, events, frames);
+        const auto total_ms = times.emit_ms + times.swap_ms + times.read_ms;
+        std::cout << std::setw(10) << producers << std::setw(12) << times.emit_ms << std::setw(12) << times.swap_ms
+                  << std::setw(12) << times.read_ms << std::setw(16) << static_cast<double>(events) / total_ms / 1e3 << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "ecs/cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace game::ecs;
+
+namespace {
+
+constexpr std::size_t MAX_THREADS = 64;
+
+template<typename F>
+double run_threads(const std::size_t threads, F&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&body, t] { body(t); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief Every thread bumps its own counter; counters are packed or padded.
+ */
+template<typename Counter>
+double bench_counters(const std::size_t threads, const std::uint64_t increments) {
+    std::vector<Counter> counters(MAX_THREADS);
+    return run_threads(threads, [&](const std::size_t t) {
+        auto& counter = counters[t];
+        for (std::uint64_t i = 0; i < increments; ++i) {
+            auto& value = [&]() -> std::atomic<std::uint64_t>& {
+                if constexpr (std::is_same_v<Counter, std::atomic<std::uint64_t>>) {
+                    return counter;
+                } else {
+                    return *counter;
+                }
+            }();
+            value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    });
+}
+
+/**
+ * @brief Threads write interleaved chunks of one shared, line-aligned float pool.
+ */
+double bench_chunks(const std::size_t threads, const std::size_t grain, const int passes) {
+    CacheAlignedVector<float> pool(1 << 16, 0.0f);
+    const std::size_t chunks = (pool.size() + grain - 1) / grain;
+
+    return run_threads(threads, [&](const std::size_t t) {
+        for (int pass = 0; pass < passes; ++pass) {
+            for (std::size_t chunk = t; chunk < chunks; chunk += threads) {
+                const auto end = std::min(pool.size(), (chunk + 1) * grain);
+                for (std::size_t i = chunk * grain; i < end; ++i) {
+                    pool[i] += 1.0f;
+                }
+            }
+        }
+    });
+}
+
+}
+
+/**
+ * Shows how parallel write throughput scales with and without cache-line
+ * separation.
+ *
+ * Usage: false_sharing_bench [max_threads]
+ * Counters: each thread increments its own counter, packed next to each
+ * other or wrapped in CachePadded. Chunks: threads write interleaved
+ * chunks of a pool, split at 24 floats (boundaries inside a line) or at
+ * cache_aligned_grain<float>(24) (boundaries on lines).
+ */
+int main(int argc, char** argv) {
+    const std::size_t max_threads = std::min<std::size_t>(MAX_THREADS, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16);
+    constexpr std::uint64_t increments = 20'000'000;
+    constexpr int passes = 2000;
+    constexpr std::size_t naive_grain = 24;
+    constexpr std::size_t aligned_grain = cache_aligned_grain<float>(naive_grain);
+
+    std::cout << "=== False sharing benchmark ===\n"
+              << std::thread::hardware_concurrency() << " hardware threads; times in ms\n"
+              << "Counters do fixed work per thread (flat = perfect scaling); chunks split fixed total work\n\n"
+              << std::setw(8) << "threads" << std::setw(16) << "packed ctrs" << std::setw(16) << "padded ctrs"
+              << std::setw(16) << "chunks @" + std::to_string(naive_grain) << std::setw(16) << "chunks @" + std::to_string(aligned_grain) << "\n"
+              << std::fixed << std::setprecision(1);
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << std::setw(8) << threads
+                  << std::setw(16) << bench_counters<std::atomic<std::uint64_t>>(threads, increments)
+                  << std::setw(16) << bench_counters<CachePadded<std::atomic<std::uint64_t>>>(threads, increments)
+                  << std::setw(16) << bench_chunks(threads, naive_grain, passes)
+                  << std::setw(16) << bench_chunks(threads, aligned_grain, passes) << "\n";
+    }
+    return 0;
+}
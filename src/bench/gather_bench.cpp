@@ -0,0 +1,116 @@
+#include "ecs/world.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+using namespace game::ecs;
+
+namespace {
+
+/**
+ * @brief Cache-line sized component, so every lookup touches its own line.
+ */
+struct Transform {
+    float values[16]{};
+};
+
+template<typename F>
+double time_ms(const int repeats, F&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        body();
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repeats;
+}
+
+}
+
+/**
+ * Compares random-access reads of one component for a list of entities.
+ *
+ * Usage: gather_bench [lookups] [repeats]
+ * Defaults to 1M lookups spread over a full pool of MAX_ENTITIES. The
+ * hash map row reproduces the entity-to-index map ComponentArray used
+ * before it switched to a sparse array.
+ */
+int main(int argc, char** argv) {
+    const std::size_t lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    World world;
+    world.register_component<Transform>();
+
+    std::vector<Entity> entities;
+    for (std::size_t i = 0; i < MAX_ENTITIES; ++i) {
+        const auto entity = world.add_entity();
+        Transform transform;
+        transform.values[0] = static_cast<float>(i);
+        world.add_component(entity, transform);
+        entities.push_back(entity);
+    }
+
+    // Shuffle storage order so dense slots do not follow entity IDs
+    std::mt19937 rng(42);
+    for (std::size_t i = 0; i < MAX_ENTITIES / 2; ++i) {
+        const auto entity = entities[rng() % entities.size()];
+        const auto transform = world.get_component<Transform>(entity);
+        world.remove_component<Transform>(entity);
+        world.add_component(entity, transform);
+    }
+
+    std::vector<Entity> targets(lookups);
+    for (auto& target : targets) {
+        target = entities[rng() % entities.size()];
+    }
+
+    const auto& pool = world.get_component_array<Transform>();
+    std::unordered_map<Entity, std::size_t> hash_index;
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        hash_index[pool.entity_at(i)] = i;
+    }
+
+    std::vector<Transform> out(lookups);
+    float sink = 0.0f;
+
+    const double hash_ms = time_ms(repeats, [&] {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            out[i] = pool.data()[hash_index.at(targets[i])];
+        }
+        sink += out[lookups / 2].values[0];
+    });
+
+    const double loop_ms = time_ms(repeats, [&] {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            out[i] = world.get_component<Transform>(targets[i]);
+        }
+        sink += out[lookups / 2].values[0];
+    });
+
+    const double gather_ms = time_ms(repeats, [&] {
+        pool.gather(targets, out);
+        sink += out[lookups / 2].values[0];
+    });
+
+    const double many_ms = time_ms(repeats, [&] {
+        world.get_many<Transform>(targets, std::span<Transform>(out));
+        sink += out[lookups / 2].values[0];
+    });
+
+    std::cout << "=== Gather benchmark ===\n"
+              << lookups << " random lookups over " << MAX_ENTITIES << " entities, "
+              << sizeof(Transform) << "-byte component\n\n"
+              << std::fixed << std::setprecision(2)
+              << std::setw(28) << std::left << "hash map per entity" << hash_ms << " ms\n"
+              << std::setw(28) << "get_component per entity" << loop_ms << " ms\n"
+              << std::setw(28) << "ComponentArray::gather" << gather_ms << " ms\n"
+              << std::setw(28) << "World::get_many" << many_ms << " ms\n"
+              << "\n(checksum " << sink << ")\n";
+    return 0;
+}
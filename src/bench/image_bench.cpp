@@ -0,0 +1,266 @@
+#include "ecs/component_storage.hpp"
+#include "ecs/double_buffered_array.hpp"
+#include "ecs/mapped_world_image.hpp"
+#include "ecs/reflection.hpp"
+#include "ecs/world.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <unistd.h>
+
+using namespace game::ecs;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float dx, dy;
+};
+
+/**
+ * @brief Not trivially copyable, so it is checkpointed as a serialized record.
+ */
+struct Label {
+    std::string name;
+    int rank{0};
+};
+
+/**
+ * @brief Rarely touched state; its pages are compressed before checkpointing.
+ */
+struct Dormant {
+    float values[8];
+};
+
+/**
+ * @brief Rewritten right before each checkpoint, so its newest values are never published.
+ */
+struct Heading {
+    float angle;
+};
+
+}
+
+ECS_REFLECT(Label, name, rank)
+ECS_COLD_STORAGE(Dormant)
+ECS_DOUBLE_BUFFERED(Heading)
+
+namespace {
+
+void register_components(World& world) {
+    world.register_component<Position>();
+    world.register_component<Velocity>();
+    world.register_component<Label>();
+    world.register_component<Dormant>();
+    world.register_component<Heading>();
+}
+
+void register_image(MappedWorldImage& image) {
+    image.register_component<Position>(1);
+    image.register_component<Velocity>(2);
+    image.register_component<Label>(3, 64);
+    image.register_component<Dormant>(4);
+    image.register_component<Heading>(5);
+}
+
+/**
+ * @brief Fills the world, then punches holes so the recycling queue and enabled mask matter.
+ */
+void populate(World& world) {
+    for (std::size_t i = 0; i < MAX_ENTITIES; ++i) {
+        const auto entity = world.add_entity();
+        const auto value = static_cast<float>(i);
+        world.add_component(entity, Position{value, -value});
+        if (i % 2 == 0) {
+            world.add_component(entity, Velocity{1.0f, value * 0.5f});
+        }
+        if (i % 3 == 0) {
+            world.add_component(entity, Label{"entity_" + std::to_string(i), static_cast<int>(i)});
+        }
+        if (i % 4 == 0) {
+            world.add_component(entity, Dormant{{value, value + 1.0f}});
+        }
+        if (i % 5 == 0) {
+            world.add_component(entity, Heading{value});
+        }
+    }
+
+    for (Entity entity = 0; entity < MAX_ENTITIES; entity += 7) {
+        world.remove_entity(entity);
+    }
+    for (Entity entity = 1; entity < MAX_ENTITIES; entity += 5) {
+        if (world.is_entity_alive(entity)) {
+            world.set_entity_enabled(entity, false);
+        }
+    }
+
+    world.get_component_array<Dormant>().set_idle_ticks(0);
+    world.tick(0.0f);
+    world.tick(0.0f);
+}
+
+/**
+ * @brief Turns every Heading mid-frame, leaving the writes in the back buffer.
+ * @return Number of components whose published value is now stale
+ */
+std::size_t turn_headings(World& world, const float angle) {
+    std::size_t stale = 0;
+    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+        if (world.is_entity_alive(entity) && world.has_component<Heading>(entity)) {
+            auto& heading = world.get_component<Heading>(entity);
+            heading.angle = angle + static_cast<float>(entity);
+            stale += std::as_const(world).get_component<Heading>(entity).angle != heading.angle;
+        }
+    }
+    return stale;
+}
+
+/**
+ * @brief Compares everything a checkpoint is meant to preserve.
+ * @return Description of the first difference, or empty if the worlds match
+ */
+std::string compare(const World& expected, const World& actual) {
+    if (expected.get_entity_count() != actual.get_entity_count()) {
+        return "entity count";
+    }
+    if (expected.get_available_entities() != actual.get_available_entities()) {
+        return "recycling queue";
+    }
+
+    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+        if (expected.get_signature(entity) != actual.get_signature(entity)) {
+            return "signature of entity " + std::to_string(entity);
+        }
+        if (!expected.is_entity_alive(entity)) {
+            continue;
+        }
+        if (expected.is_entity_enabled(entity) != actual.is_entity_enabled(entity)) {
+            return "enabled bit of entity " + std::to_string(entity);
+        }
+
+        const auto& p0 = expected.get_component<Position>(entity);
+        const auto& p1 = actual.get_component<Position>(entity);
+        if (p0.x != p1.x || p0.y != p1.y) {
+            return "Position of entity " + std::to_string(entity);
+        }
+        if (expected.has_component<Velocity>(entity)) {
+            const auto& v0 = expected.get_component<Velocity>(entity);
+            const auto& v1 = actual.get_component<Velocity>(entity);
+            if (v0.dx != v1.dx || v0.dy != v1.dy) {
+                return "Velocity of entity " + std::to_string(entity);
+            }
+        }
+        if (expected.has_component<Label>(entity)) {
+            const auto& l0 = expected.get_component<Label>(entity);
+            const auto& l1 = actual.get_component<Label>(entity);
+            if (l0.name != l1.name || l0.rank != l1.rank) {
+                return "Label of entity " + std::to_string(entity);
+            }
+        }
+        if (expected.has_component<Dormant>(entity)
+            && expected.get_component<Dormant>(entity).values[0] != actual.get_component<Dormant>(entity).values[0]) {
+            return "Dormant of entity " + std::to_string(entity);
+        }
+        // A checkpoint keeps this frame's writes, which const access would not show yet
+        if (expected.has_component<Heading>(entity)
+            && latest<Heading>(expected.get_component_array<Heading>()).get(entity).angle
+                   != actual.get_component<Heading>(entity).angle) {
+            return "unpublished Heading of entity " + std::to_string(entity);
+        }
+    }
+    return {};
+}
+
+double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}
+
+/**
+ * Measures MappedWorldImage checkpoint and warm-restart latency.
+ *
+ * Usage: image_bench [rounds]
+ * Fills a MAX_ENTITIES world with plain, serialized and cold components,
+ * removes and disables some entities, then checkpoints it the given
+ * number of times (default 20). After each checkpoint the image is
+ * reopened for a fresh World, restored, and checked for entity IDs,
+ * signatures, enabled bits, the recycling queue and component values
+ * against the original. A double-buffered component is rewritten before
+ * every checkpoint without publishing, and the restored world must hold
+ * the new values. Exits with 1 on any difference.
+ */
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+    const auto path = std::filesystem::temp_directory_path() / ("image_bench_" + std::to_string(getpid()) + ".img");
+
+    World world;
+    register_components(world);
+    populate(world);
+    const auto& dormant = world.get_component_array<Dormant>();
+    const auto cold_pages = dormant.cold_page_count();
+
+    MappedWorldImage image(world);
+    register_image(image);
+    if (!image.open(path)) {
+        std::cerr << "could not map " << path << "\n";
+        return 1;
+    }
+
+    double checkpoint_ms = 0.0;
+    double restore_ms = 0.0;
+    std::uint64_t thaws = 0;
+    for (int round = 0; round < rounds; ++round) {
+        if (turn_headings(world, static_cast<float>(round + 1) * 1000.0f) == 0) {
+            std::cerr << "mid-frame writes were published before the checkpoint\n";
+            return 1;
+        }
+
+        const auto thaws_before = dormant.get_thaw_count();
+        auto start = std::chrono::steady_clock::now();
+        if (!image.checkpoint()) {
+            std::cerr << "checkpoint " << round << " failed\n";
+            return 1;
+        }
+        checkpoint_ms += elapsed_ms(start);
+        thaws += dormant.get_thaw_count() - thaws_before;
+
+        World restored;
+        register_components(restored);
+        MappedWorldImage restart(restored);
+        register_image(restart);
+        start = std::chrono::steady_clock::now();
+        if (!restart.open(path) || !restart.restore()) {
+            std::cerr << "restore " << round << " failed\n";
+            return 1;
+        }
+        restore_ms += elapsed_ms(start);
+
+        if (const auto difference = compare(world, restored); !difference.empty()) {
+            std::cerr << "restored world differs: " << difference << "\n";
+            return 1;
+        }
+    }
+
+    image.close();
+    std::filesystem::remove(path);
+
+    std::cout << "=== Mapped world image benchmark ===\n"
+              << world.get_entity_count() << " entities, " << cold_pages << " cold pages, " << rounds << " rounds\n"
+              << std::fixed << std::setprecision(3)
+              << "checkpoint: " << checkpoint_ms / rounds << " ms\n"
+              << "open + restore: " << restore_ms / rounds << " ms\n"
+              << "cold pages thawed by checkpoints: " << thaws << "\n"
+              << "restored worlds match the original, including unpublished writes\n";
+    return 0;
+}
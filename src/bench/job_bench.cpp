@@ -0,0 +1,142 @@
+#include "ecs/job_system.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace game::ecs;
+
+namespace {
+
+volatile std::uint64_t sink = 0;
+
+/**
+ * @brief Burns roughly units * a few ns of CPU.
+ */
+void spin(const std::uint64_t units) {
+    std::uint64_t value = units;
+    for (std::uint64_t i = 0; i < units * 16; ++i) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    sink = sink + value;
+}
+
+template<typename F>
+double time_ms(F&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief Cost of spawning, running and waiting for one empty job, in ns.
+ */
+double bench_spawn(JobSystem& jobs, const std::size_t count) {
+    JobCounter counter;
+    const auto ms = time_ms([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            jobs.spawn([] {}, counter);
+        }
+        jobs.wait(counter);
+    });
+    return ms * 1e6 / static_cast<double>(count);
+}
+
+/**
+ * @brief Work whose cost grows with the index, so an even split is badly unbalanced.
+ */
+std::uint64_t skewed_cost(const std::size_t i, const std::size_t count) {
+    return 1 + (i * i * 64) / (count * count);
+}
+
+double bench_static_split(JobSystem& jobs, const std::size_t count) {
+    const auto workers = jobs.get_worker_count();
+    return time_ms([&] {
+        JobCounter counter;
+        for (std::size_t w = 0; w < workers; ++w) {
+            jobs.spawn([w, workers, count] {
+                for (auto i = w * count / workers; i < (w + 1) * count / workers; ++i) {
+                    spin(skewed_cost(i, count));
+                }
+            }, counter);
+        }
+        jobs.wait(counter);
+    });
+}
+
+double bench_parallel_for(JobSystem& jobs, const std::size_t count) {
+    return time_ms([&] {
+        jobs.parallel_for(count, 16, [count](auto begin, auto end, auto) {
+            for (auto i = begin; i < end; ++i) {
+                spin(skewed_cost(i, count));
+            }
+        });
+    });
+}
+
+/**
+ * @brief Runs a graph of layers fully connected to the next layer.
+ */
+double bench_graph(JobSystem& jobs, const std::size_t layers, const std::size_t width) {
+    TaskGraph graph;
+    std::vector<TaskGraph::TaskId> previous;
+    for (std::size_t layer = 0; layer < layers; ++layer) {
+        std::vector<TaskGraph::TaskId> current;
+        for (std::size_t i = 0; i < width; ++i) {
+            current.push_back(graph.add([] { spin(64); }));
+            for (const auto before : previous) {
+                graph.precede(before, current.back());
+            }
+        }
+        previous = std::move(current);
+    }
+    jobs.run(graph);
+    return time_ms([&] { jobs.run(graph); });
+}
+
+}
+
+/**
+ * Measures the overheads of JobSystem.
+ *
+ * Usage: job_bench [max_threads]
+ * spawn: ns to spawn, run and wait for one empty job (100k per batch).
+ * static / stealing: 20k items whose cost grows quadratically with the
+ * index, split evenly per worker vs parallel_for's adaptive splitting;
+ * efficiency is serial time / (threads * stealing time).
+ * graph: 16 layers of 32 tasks, each layer depending on all of the last.
+ */
+int main(int argc, char** argv) {
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16;
+    constexpr std::size_t spawns = 100'000;
+    constexpr std::size_t items = 20'000;
+
+    double serial = 0.0;
+    {
+        JobSystem jobs(1);
+        serial = bench_parallel_for(jobs, items);
+    }
+
+    std::cout << "=== Job system benchmark ===\n"
+              << std::thread::hardware_concurrency() << " hardware threads; serial skewed loop " << std::fixed
+              << std::setprecision(1) << serial << " ms\n\n"
+              << std::setw(8) << "threads" << std::setw(14) << "spawn ns" << std::setw(14) << "static ms"
+              << std::setw(14) << "stealing ms" << std::setw(14) << "efficiency" << std::setw(14) << "graph ms" << "\n";
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        JobSystem jobs(threads);
+        const auto stealing = bench_parallel_for(jobs, items);
+        std::cout << std::setw(8) << threads
+                  << std::setw(14) << bench_spawn(jobs, spawns)
+                  << std::setw(14) << bench_static_split(jobs, items)
+                  << std::setw(14) << stealing
+                  << std::setw(13) << 100.0 * serial / (static_cast<double>(threads) * stealing) << "%"
+                  << std::setw(14) << std::setprecision(2) << bench_graph(jobs, 16, 32) << std::setprecision(1) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "ecs/world.hpp"
+#include "ecs/write_ahead_journal.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using namespace game::ecs;
+
+namespace {
+
+constexpr double TARGET_PER_SECOND = 100'000.0;
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float dx, dy;
+};
+
+void populate(World& world) {
+    world.register_component<Position>();
+    world.register_component<Velocity>();
+    for (std::size_t i = 0; i < MAX_ENTITIES; ++i) {
+        const auto entity = world.add_entity();
+        world.add_component(entity, Position{static_cast<float>(i), 0.0f});
+        world.add_component(entity, Velocity{1.0f, 0.5f});
+    }
+}
+
+/**
+ * @brief Moves every entity and reports the write; one frame is MAX_ENTITIES mutations.
+ */
+void mutate_frame(World& world) {
+    for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+        auto& position = world.get_component<Position>(entity);
+        const auto& velocity = std::as_const(world).get_component<Velocity>(entity);
+        position.x += velocity.dx;
+        position.y += velocity.dy;
+        world.mark_component_changed<Position>(entity);
+    }
+}
+
+struct Result {
+    double append_per_second;
+    double durable_per_second;
+    std::uint64_t file_bytes;
+};
+
+/**
+ * @brief Journals the given number of frames, flushing every flush_every frames (0 for once at the end).
+ */
+Result run(const std::filesystem::path& path, const std::size_t group_commit_bytes,
+           const std::chrono::milliseconds interval, const int frames, const int flush_every) {
+    std::filesystem::remove(path);
+    World world;
+    populate(world);
+
+    WriteAheadJournal journal(world, interval, group_commit_bytes);
+    journal.register_component<Position>(1);
+    journal.register_component<Velocity>(2);
+    if (!journal.open(path)) {
+        std::cerr << "cannot open " << path << "\n";
+        std::exit(1);
+    }
+
+    double append_ns = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        const auto frame_start = std::chrono::steady_clock::now();
+        mutate_frame(world);
+        const std::chrono::duration<double, std::nano> mutate = std::chrono::steady_clock::now() - frame_start;
+        append_ns += mutate.count();
+
+        if (flush_every > 0 && (frame + 1) % flush_every == 0) {
+            (void)journal.flush();
+        }
+    }
+    if (!journal.flush()) {
+        std::cerr << "journal write failed\n";
+        std::exit(1);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    journal.close();
+
+    const auto mutations = static_cast<double>(frames) * MAX_ENTITIES;
+    return Result{mutations / (append_ns / 1e9), mutations / elapsed.count(), std::filesystem::file_size(path)};
+}
+
+}
+
+/**
+ * Measures WriteAheadJournal append and group-commit throughput.
+ *
+ * Usage: journal_bench [frames]
+ * Every frame moves all MAX_ENTITIES entities and marks their Position
+ * changed, i.e. MAX_ENTITIES journaled mutations. Runs the given number
+ * of frames (default 200, 1M mutations) with several group commit sizes,
+ * then with an fdatasync forced every frame and every 6 frames (10 Hz at
+ * 60 fps). "append" counts only the time spent on the game thread;
+ * "durable" includes waiting for the last group to reach the disk.
+ */
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 200;
+    const auto path = std::filesystem::temp_directory_path() / ("journal_bench_" + std::to_string(getpid()) + ".jnl");
+
+    struct Config {
+        const char* name;
+        std::size_t group_commit_bytes;
+        std::chrono::milliseconds interval;
+        int flush_every;
+    };
+    const Config configs[] = {
+        {"group 64 KiB", 64 << 10, std::chrono::milliseconds(100), 0},
+        {"group 1 MiB", 1 << 20, std::chrono::milliseconds(100), 0},
+        {"group 8 MiB", 8 << 20, std::chrono::milliseconds(100), 0},
+        {"sync every 6 frames", 1 << 20, std::chrono::milliseconds(100), 6},
+        {"sync every frame", 1 << 20, std::chrono::milliseconds(100), 1},
+    };
+
+    std::cout << "=== Write-ahead journal benchmark ===\n"
+              << frames << " frames x " << MAX_ENTITIES << " mutations, target "
+              << TARGET_PER_SECOND / 1e3 << "k durable mutations/s\n\n" << std::fixed << std::setprecision(0)
+              << std::setw(22) << "" << std::setw(16) << "append/s" << std::setw(16) << "durable/s"
+              << std::setw(12) << "file MB" << std::setw(10) << "target" << "\n";
+
+    for (const auto& config : configs) {
+        const auto result = run(path, config.group_commit_bytes, config.interval, frames, config.flush_every);
+        std::cout << std::setw(22) << config.name << std::setw(16) << result.append_per_second
+                  << std::setw(16) << result.durable_per_second << std::setprecision(1)
+                  << std::setw(12) << static_cast<double>(result.file_bytes) / (1024.0 * 1024.0) << std::setprecision(0)
+                  << std::setw(10) << (result.durable_per_second >= TARGET_PER_SECOND ? "met" : "missed") << "\n";
+    }
+
+    std::filesystem::remove(path);
+    return 0;
+}
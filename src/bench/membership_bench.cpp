@@ -0,0 +1,128 @@
+#include "ecs/system.hpp"
+#include "ecs/world.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace game::ecs;
+
+namespace {
+
+constexpr std::size_t COMPONENT_COUNT = 16;
+constexpr std::size_t ENTITY_COUNT = 2000;
+constexpr int MAX_SYSTEMS = 500;
+
+template<std::size_t N>
+struct Component {
+    float value;
+};
+
+template<int N>
+class EmptySystem : public System {
+public:
+    void tick(float) override {}
+};
+
+template<std::size_t... Ns>
+void register_components(World& world, std::index_sequence<Ns...>) {
+    (world.register_component<Component<Ns>>(), ...);
+}
+
+/**
+ * @brief Registers the first count systems, each requiring 1 to 3 random components.
+ */
+template<int... Ns>
+void register_systems(World& world, const int count, std::mt19937& rng, std::integer_sequence<int, Ns...>) {
+    std::uniform_int_distribution<std::size_t> component(0, COMPONENT_COUNT - 1);
+    std::uniform_int_distribution<int> width(1, 3);
+    const auto register_one = [&]<int N>(std::integral_constant<int, N>) {
+        if (N >= count) {
+            return;
+        }
+        (void)world.register_system<EmptySystem<N>>();
+        Signature signature;
+        for (int i = width(rng); i > 0; --i) {
+            signature.set(component(rng));
+        }
+        world.set_system_signature<EmptySystem<N>>(signature);
+    };
+    (register_one(std::integral_constant<int, Ns>{}), ...);
+}
+
+template<std::size_t... Ns>
+void add_component(World& world, const Entity entity, const std::size_t type, std::index_sequence<Ns...>) {
+    ((type == Ns ? world.add_component(entity, Component<Ns>{1.0f}) : void()), ...);
+}
+
+template<std::size_t... Ns>
+void remove_component(World& world, const Entity entity, const std::size_t type, std::index_sequence<Ns...>) {
+    ((type == Ns ? world.remove_component<Component<Ns>>(entity) : void()), ...);
+}
+
+/**
+ * @brief ns per structural change (one add or one remove) with count systems registered.
+ */
+double ns_per_change(const int count, const int rounds) {
+    constexpr auto components = std::make_index_sequence<COMPONENT_COUNT>{};
+    std::mt19937 rng(42);
+
+    World world;
+    register_components(world, components);
+    register_systems(world, count, rng, std::make_integer_sequence<int, MAX_SYSTEMS>{});
+
+    // Every entity holds half of the components, so most changes complete or break some signature
+    std::vector<Entity> entities;
+    for (std::size_t i = 0; i < ENTITY_COUNT; ++i) {
+        entities.push_back(world.add_entity());
+        for (std::size_t type = 0; type < COMPONENT_COUNT; type += 2) {
+            add_component(world, entities.back(), type, components);
+        }
+    }
+
+    std::uniform_int_distribution<std::size_t> odd(0, COMPONENT_COUNT / 2 - 1);
+    std::vector<std::size_t> types(ENTITY_COUNT);
+    for (auto& type : types) {
+        type = odd(rng) * 2 + 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < ENTITY_COUNT; ++i) {
+            add_component(world, entities[i], types[i], components);
+        }
+        for (std::size_t i = 0; i < ENTITY_COUNT; ++i) {
+            remove_component(world, entities[i], types[i], components);
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (2.0 * ENTITY_COUNT * rounds);
+}
+
+}
+
+/**
+ * Measures the cost of adding and removing components as the number of
+ * registered systems grows. Each system requires 1 to 3 of 16 component
+ * types; 2000 entities each hold 8 of them and repeatedly gain and lose
+ * one more. Only systems requiring the changed component are visited, so
+ * the cost grows with the systems per component, not the total.
+ *
+ * Usage: membership_bench [rounds]
+ */
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    std::cout << "=== System membership benchmark ===\n" << ENTITY_COUNT << " entities, " << COMPONENT_COUNT
+              << " component types; ns per add/remove\n\n"
+              << std::setw(10) << "systems" << std::setw(14) << "ns/change" << "\n" << std::fixed << std::setprecision(1);
+
+    for (const int count : {10, 50, 100, 200, 500}) {
+        std::cout << std::setw(10) << count << std::setw(14) << ns_per_change(count, rounds) << "\n";
+    }
+    return 0;
+}
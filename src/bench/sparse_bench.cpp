@@ -0,0 +1,160 @@
+#include "ecs/entity_bitset.hpp"
+#include "ecs/world.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+
+using namespace game::ecs;
+
+namespace {
+
+constexpr std::size_t LARGE_COUNT = 1 << 20;
+
+using LargeBitset = EntityBitset<LARGE_COUNT>;
+
+volatile std::uint64_t sink = 0;
+
+struct Position {
+    float x, y;
+};
+
+struct Lifetime {
+    float remaining;
+};
+
+template<typename F>
+double ns_per_run(const int runs, F&& run) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        run();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / runs;
+}
+
+/**
+ * @brief Intersects a set at the given density with a half-full one over 1M IDs.
+ */
+void bench_large(const double density, const int runs) {
+    auto sparse = std::make_unique<LargeBitset>();
+    auto half = std::make_unique<LargeBitset>();
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    for (Entity entity = 0; entity < LARGE_COUNT; ++entity) {
+        if (coin(rng) < density) {
+            sparse->set(entity);
+        }
+        if (coin(rng) < 0.5) {
+            half->set(entity);
+        }
+    }
+
+    const auto hierarchical = ns_per_run(runs, [&] {
+        std::uint64_t sum = 0;
+        sparse->for_each_intersection([&](const Entity entity) { sum += entity; }, *half);
+        sink = sink + sum;
+    });
+    // Leaf words only, as without the summary level
+    const auto flat = ns_per_run(runs, [&] {
+        std::uint64_t sum = 0;
+        const auto& a = sparse->words();
+        const auto& b = half->words();
+        for (std::size_t word = 0; word < LargeBitset::WORD_COUNT; ++word) {
+            for (auto bits = a[word] & b[word]; bits != 0; bits &= bits - 1) {
+                sum += word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+            }
+        }
+        sink = sink + sum;
+    });
+    const auto per_id = ns_per_run(runs, [&] {
+        std::uint64_t sum = 0;
+        for (Entity entity = 0; entity < LARGE_COUNT; ++entity) {
+            if (sparse->test(entity) && half->test(entity)) {
+                sum += entity;
+            }
+        }
+        sink = sink + sum;
+    });
+
+    std::cout << std::setw(9) << density * 100.0 << "%" << std::setw(14) << hierarchical / 1e3
+              << std::setw(14) << flat / 1e3 << std::setw(14) << per_id / 1e3 << "\n";
+}
+
+/**
+ * @brief Every entity has a Position, a fraction also a Lifetime.
+ */
+void bench_world(const double density, const int runs) {
+    World world;
+    world.register_component<Position>();
+    world.register_component<Lifetime>();
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    for (std::size_t i = 0; i < MAX_ENTITIES; ++i) {
+        const auto entity = world.add_entity();
+        world.add_component(entity, Position{static_cast<float>(i), 0.0f});
+        if (coin(rng) < density) {
+            world.add_component(entity, Lifetime{1.0f});
+        }
+    }
+
+    const auto dense_first = ns_per_run(runs, [&] {
+        float sum = 0.0f;
+        world.view<const Position, const Lifetime>().each([&](Entity, const Position&, const Lifetime& lifetime) {
+            sum += lifetime.remaining;
+        });
+        sink = sink + static_cast<std::uint64_t>(sum);
+    });
+    const auto rare_first = ns_per_run(runs, [&] {
+        float sum = 0.0f;
+        world.view<const Lifetime, const Position>().each([&](Entity, const Lifetime& lifetime, const Position&) {
+            sum += lifetime.remaining;
+        });
+        sink = sink + static_cast<std::uint64_t>(sum);
+    });
+    const auto intersection = ns_per_run(runs, [&] {
+        float sum = 0.0f;
+        world.each_intersection<const Lifetime, const Position>([&](Entity, const Lifetime& lifetime, const Position&) {
+            sum += lifetime.remaining;
+        });
+        sink = sink + static_cast<std::uint64_t>(sum);
+    });
+
+    std::cout << std::setw(9) << density * 100.0 << "%" << std::setw(14) << dense_first / 1e3
+              << std::setw(14) << rare_first / 1e3 << std::setw(14) << intersection / 1e3 << "\n";
+}
+
+}
+
+/**
+ * Measures sparse intersections at 0.1%, 1% and 10% density.
+ *
+ * Usage: sparse_bench [runs]
+ * First intersects a sparse and a half-full EntityBitset over 1M IDs,
+ * with the summary level, with leaf words only, and bit by bit. Then,
+ * in a full World where some entities also have a Lifetime, joins
+ * Position and Lifetime with a view driven by the dense pool, a view
+ * driven by the sparse pool, and World::each_intersection().
+ */
+int main(int argc, char** argv) {
+    const int runs = argc > 1 ? std::atoi(argv[1]) : 50;
+    constexpr double densities[] = {0.001, 0.01, 0.1};
+
+    std::cout << "=== Sparse intersection benchmark ===\n\n1M IDs, sparse AND 50%; us per pass\n"
+              << std::fixed << std::setprecision(1) << std::setw(10) << "density" << std::setw(14) << "summary"
+              << std::setw(14) << "leaf words" << std::setw(14) << "per ID" << "\n";
+    for (const auto density : densities) {
+        bench_large(density, runs);
+    }
+
+    std::cout << "\n" << MAX_ENTITIES << "-entity world, Position AND Lifetime; us per pass\n"
+              << std::setprecision(2) << std::setw(10) << "density" << std::setw(14) << "view dense"
+              << std::setw(14) << "view rare" << std::setw(14) << "intersection" << "\n";
+    for (const auto density : densities) {
+        bench_world(density, runs * 20);
+    }
+    return 0;
+}
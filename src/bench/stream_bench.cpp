@@ -0,0 +1,185 @@
+#include "ecs/region_streamer.hpp"
+#include "ecs/world.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace game::ecs;
+
+namespace {
+
+constexpr std::size_t RESIDENT_REGIONS = 4;
+constexpr std::size_t REGION_SIZE = MAX_ENTITIES / (RESIDENT_REGIONS + 1);
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float dx, dy;
+};
+
+/**
+ * @brief Stand-in for the bulkier per-entity state a streamed region carries.
+ */
+struct Payload {
+    float values[16];
+};
+
+/**
+ * @brief Resident set size of the process in bytes.
+ */
+std::size_t resident_bytes() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    statm >> size >> resident;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * @brief Peak resident set size of the process in bytes.
+ */
+std::size_t peak_resident_bytes() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+}
+
+void spawn_region(World& world, const RegionId region) {
+    for (std::size_t i = 0; i < REGION_SIZE; ++i) {
+        const auto entity = world.add_entity();
+        const auto value = static_cast<float>(region * REGION_SIZE + i);
+        world.add_component(entity, Region{region});
+        world.add_component(entity, Position{value, -value});
+        world.add_component(entity, Velocity{1.0f, 0.5f});
+        world.add_component(entity, Payload{{value}});
+    }
+}
+
+double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}
+
+/**
+ * Measures streaming regions through a full world with bounded memory.
+ *
+ * Usage: stream_bench [regions] [laps] [commit_budget]
+ * Seeds the given number of regions (default 64) of MAX_ENTITIES / 5
+ * entities each to disk, then walks a window of 4 resident regions
+ * across them for the given number of laps (default 3): every step
+ * evicts the oldest region and loads the next one, committing at most
+ * commit_budget entities (default 250) per simulated frame. The world
+ * never holds more than MAX_ENTITIES entities, so peak RSS should stop
+ * growing after the first lap no matter how many regions exist.
+ */
+int main(int argc, char** argv) {
+    const RegionId region_count = argc > 1 ? static_cast<RegionId>(std::strtoul(argv[1], nullptr, 10)) : 64;
+    const int laps = argc > 2 ? std::atoi(argv[2]) : 3;
+    const std::size_t budget = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 250;
+
+    const auto directory = std::filesystem::temp_directory_path() / ("stream_bench_" + std::to_string(getpid()));
+    const auto baseline = resident_bytes();
+
+    World world;
+    world.register_component<Region>();
+    world.register_component<Position>();
+    world.register_component<Velocity>();
+    world.register_component<Payload>();
+
+    {
+        RegionStreamer streamer(world, directory);
+        streamer.register_component<Position>(1);
+        streamer.register_component<Velocity>(2);
+        streamer.register_component<Payload>(3);
+
+        for (RegionId region = 0; region < region_count; ++region) {
+            spawn_region(world, region);
+            if (!streamer.evict_region(region)) {
+                std::cerr << "region " << region << " refused\n";
+                return 1;
+            }
+        }
+
+        std::deque<RegionId> resident;
+        RegionId next = 0;
+        const auto load = [&](std::size_t& frames) {
+            streamer.request_load(next);
+            while (!streamer.is_resident(next)) {
+                if (streamer.get_state(next) == RegionStreamer::RegionState::Evicted) {
+                    std::cerr << "region " << next << " failed to load\n";
+                    std::exit(1);
+                }
+                if (streamer.commit(budget) == 0) {
+                    std::this_thread::yield();
+                }
+                ++frames;
+            }
+            resident.push_back(next);
+            next = (next + 1) % region_count;
+        };
+
+        std::size_t warmup_frames = 0;
+        while (resident.size() < RESIDENT_REGIONS) {
+            load(warmup_frames);
+        }
+
+        constexpr double MB = 1024.0 * 1024.0;
+        std::cout << "=== Region streaming benchmark ===\n"
+                  << region_count << " regions of " << REGION_SIZE << " entities ("
+                  << static_cast<std::size_t>(region_count) * REGION_SIZE << " total), " << RESIDENT_REGIONS
+                  << " resident, commit budget " << budget << " per frame\n\n" << std::fixed << std::setprecision(2)
+                  << std::setw(6) << "lap" << std::setw(12) << "evict ms" << std::setw(12) << "load ms"
+                  << std::setw(14) << "frames/load" << std::setw(14) << "entities/s" << std::setw(10) << "RSS MB"
+                  << std::setw(12) << "peak MB" << "\n";
+
+        for (int lap = 0; lap < laps; ++lap) {
+            double evict_ms = 0.0;
+            double load_ms = 0.0;
+            std::size_t frames = 0;
+            for (RegionId step = 0; step < region_count; ++step) {
+                auto start = std::chrono::steady_clock::now();
+                (void)streamer.evict_region(resident.front());
+                resident.pop_front();
+                evict_ms += elapsed_ms(start);
+
+                start = std::chrono::steady_clock::now();
+                load(frames);
+                load_ms += elapsed_ms(start);
+            }
+
+            const auto steps = static_cast<double>(region_count);
+            const auto streamed = steps * static_cast<double>(REGION_SIZE);
+            std::cout << std::setw(6) << lap << std::setw(12) << evict_ms / steps << std::setw(12) << load_ms / steps
+                      << std::setw(14) << static_cast<double>(frames) / steps
+                      << std::setw(14) << std::setprecision(0) << streamed / ((evict_ms + load_ms) / 1e3)
+                      << std::setprecision(2) << std::setw(10) << (resident_bytes() - baseline) / MB
+                      << std::setw(12) << peak_resident_bytes() / MB << "\n";
+        }
+
+        std::cout << "\nentities alive " << world.get_entity_count() << " (limit " << MAX_ENTITIES << "), failed loads "
+                  << streamer.get_failed_load_count() << ", failed writes " << streamer.get_failed_write_count() << "\n";
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "ecs/world.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace game::ecs;
+
+namespace {
+
+// Page-sized components: three full pools of MAX_ENTITIES span more than
+// the last-level cache of current server parts
+constexpr std::size_t COMPONENT_FLOATS = 2048;
+
+// A join only touches one line per component, so caches are flushed by
+// streaming through a larger buffer before every timed pass
+constexpr std::size_t EVICTION_BYTES = 512ULL * 1024 * 1024;
+
+struct Body {
+    float values[COMPONENT_FLOATS]{};
+};
+
+struct Mass {
+    float values[COMPONENT_FLOATS]{};
+};
+
+struct Drag {
+    float values[COMPONENT_FLOATS]{};
+};
+
+template<typename T>
+void shuffle_pool(World& world, const std::vector<Entity>& entities, std::mt19937& rng) {
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        const auto entity = entities[rng() % entities.size()];
+        const auto component = world.get_component<T>(entity);
+        world.remove_component<T>(entity);
+        world.add_component(entity, component);
+    }
+}
+
+void evict_caches(std::vector<unsigned char>& buffer) {
+    for (std::size_t i = 0; i < buffer.size(); i += 64) {
+        buffer[i] += 1;
+    }
+}
+
+double run_join(View<Body, Mass, Drag>& view, std::vector<unsigned char>& eviction, const int repeats) {
+    double total_ms = 0.0;
+    for (int i = 0; i < repeats; ++i) {
+        evict_caches(eviction);
+
+        const auto start = std::chrono::steady_clock::now();
+        view.each([](Entity, Body& body, const Mass& mass, const Drag& drag) {
+            body.values[0] += mass.values[0] * drag.values[0];
+        });
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        total_ms += elapsed.count();
+    }
+    return total_ms / repeats;
+}
+
+}
+
+/**
+ * Measures the prefetch distance of a 3-component view join.
+ *
+ * Usage: view_bench [repeats]
+ * Secondary pools are shuffled so they are reached in random order, and
+ * every pass starts from cold caches as if the world exceeded the LLC.
+ * Every candidate distance is timed and the fastest is reported along
+ * with its gain over no prefetching, for View::set_prefetch_distance();
+ * DEFAULT_VIEW_PREFETCH_DISTANCE is not changed by it.
+ */
+int main(int argc, char** argv) {
+    const int repeats = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    World world;
+    world.register_component<Body>();
+    world.register_component<Mass>();
+    world.register_component<Drag>();
+
+    std::vector<Entity> entities;
+    for (std::size_t i = 0; i < MAX_ENTITIES; ++i) {
+        const auto entity = world.add_entity();
+        world.add_component(entity, Body{});
+        world.add_component(entity, Mass{});
+        world.add_component(entity, Drag{});
+        world.get_component<Mass>(entity).values[0] = 1.0f;
+        world.get_component<Drag>(entity).values[0] = 0.5f;
+        entities.push_back(entity);
+    }
+
+    std::mt19937 rng(7);
+    shuffle_pool<Mass>(world, entities, rng);
+    shuffle_pool<Drag>(world, entities, rng);
+
+    auto view = world.view<Body, Mass, Drag>();
+    const std::size_t candidates[] = {0, 1, 2, 4, 8, 16, 32, 64};
+
+    std::cout << "=== View prefetch benchmark ===\n"
+              << MAX_ENTITIES << " entities, 3 pools of " << sizeof(Body) * MAX_ENTITIES / (1024 * 1024)
+              << " MiB each\n\n";
+
+    std::vector<unsigned char> eviction(EVICTION_BYTES, 0);
+
+    // Warm up page tables so the first candidate is not penalized
+    run_join(view, eviction, 1);
+
+    double baseline_ms = 0.0;
+    double best_ms = 0.0;
+    std::size_t best_distance = 0;
+    for (const auto distance : candidates) {
+        view.set_prefetch_distance(distance);
+        const double ms = run_join(view, eviction, repeats);
+        if (distance == 0) {
+            baseline_ms = ms;
+        }
+        if (distance == 0 || ms < best_ms) {
+            best_ms = ms;
+            best_distance = distance;
+        }
+        std::cout << "  distance " << std::setw(3) << distance << ": " << std::fixed << std::setprecision(3)
+                  << ms << " ms\n";
+    }
+
+    std::cout << "\nBest distance: " << best_distance << " (" << std::setprecision(2)
+              << baseline_ms / best_ms << "x over no prefetch)\n";
+    return 0;
+}
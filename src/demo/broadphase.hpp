@@ -0,0 +1,605 @@
+#ifndef GAME_EXAMPLE_BROADPHASE_HPP
+#define GAME_EXAMPLE_BROADPHASE_HPP
+
+#include "ecs/entity.hpp"
+#include "ecs/world.hpp"
+#include "components.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace game {
+namespace example {
+
+/**
+ * @brief Axis-aligned bounding box in world space.
+ */
+struct Aabb {
+    float min_x{0.0f};
+    float min_y{0.0f};
+    float max_x{0.0f};
+    float max_y{0.0f};
+
+    static Aabb from_circle(const Position& position, const Collider& collider) noexcept {
+        return {position.x - collider.radius, position.y - collider.radius,
+                position.x + collider.radius, position.y + collider.radius};
+    }
+
+    static Aabb merge(const Aabb& a, const Aabb& b) noexcept {
+        return {std::min(a.min_x, b.min_x), std::min(a.min_y, b.min_y),
+                std::max(a.max_x, b.max_x), std::max(a.max_y, b.max_y)};
+    }
+
+    [[nodiscard]] Aabb fattened(const float margin) const noexcept {
+        return {min_x - margin, min_y - margin, max_x + margin, max_y + margin};
+    }
+
+    [[nodiscard]] bool overlaps(const Aabb& other) const noexcept {
+        return min_x <= other.max_x && other.min_x <= max_x
+            && min_y <= other.max_y && other.min_y <= max_y;
+    }
+
+    [[nodiscard]] bool contains(const Aabb& other) const noexcept {
+        return min_x <= other.min_x && min_y <= other.min_y
+            && other.max_x <= max_x && other.max_y <= max_y;
+    }
+
+    [[nodiscard]] float perimeter() const noexcept {
+        return 2.0f * ((max_x - min_x) + (max_y - min_y));
+    }
+};
+
+/**
+ * @brief Candidate pair produced by a broadphase, ordered first < second.
+ */
+struct CollisionPair {
+    ecs::Entity first{ecs::INVALID_ENTITY};
+    ecs::Entity second{ecs::INVALID_ENTITY};
+
+    CollisionPair() = default;
+    CollisionPair(ecs::Entity a, ecs::Entity b) : first(std::min(a, b)), second(std::max(a, b)) {}
+
+    bool operator<(const CollisionPair& other) const noexcept {
+        return first != other.first ? first < other.first : second < other.second;
+    }
+
+    bool operator==(const CollisionPair& other) const noexcept = default;
+};
+
+/**
+ * @brief Selects the broadphase a CollisionSystem uses.
+ */
+enum class BroadphaseKind {
+    UniformGrid,
+    AabbTree,
+    ParallelGrid  // Grid and narrow phase run as one multi-threaded pipeline
+};
+
+/**
+ * @brief Interface for broadphase structures fed from Position + Collider.
+ */
+class Broadphase {
+public:
+    virtual ~Broadphase() = default;
+
+    /**
+     * @brief Brings the structure in line with the current collider set.
+     *
+     * Reads go through a const World so they never mark pools written.
+     */
+    virtual void update(const ecs::World& world, const std::span<const ecs::Entity> entities) = 0;
+
+    /**
+     * @brief Appends every pair whose bounds may overlap.
+     */
+    virtual void collect_pairs(std::vector<CollisionPair>& pairs) = 0;
+};
+
+/**
+ * @brief Uniform grid rebuilt every frame.
+ *
+ * Cheap when colliders are of similar size to the cell, but a collider
+ * much larger than a cell is inserted into many cells, and cells full of
+ * tiny colliders produce many candidate pairs. Only cells occupied in
+ * the current or previous frame are kept, so the map does not grow with
+ * every cell colliders ever passed through.
+ */
+class UniformGridBroadphase final : public Broadphase {
+    struct Entry {
+        ecs::Entity entity;
+        Aabb box;
+    };
+
+    float cell_size_;
+    std::vector<Entry> entries_{};
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells_{};
+
+public:
+    explicit UniformGridBroadphase(const float cell_size = 64.0f) : cell_size_(cell_size) {}
+
+    void update(const ecs::World& world, const std::span<const ecs::Entity> entities) override {
+        entries_.clear();
+        // Cells left empty by the previous frame are dropped; the rest keep their capacity for reuse
+        std::erase_if(cells_, [](const auto& cell) { return cell.second.empty(); });
+        for (auto& [key, cell] : cells_) {
+            cell.clear();
+        }
+
+        for (const auto entity : entities) {
+            const auto box = Aabb::from_circle(world.get_component<Position>(entity),
+                                               world.get_component<Collider>(entity));
+            const auto index = static_cast<std::uint32_t>(entries_.size());
+            entries_.push_back({entity, box});
+
+            for (auto y = cell_coord(box.min_y); y <= cell_coord(box.max_y); ++y) {
+                for (auto x = cell_coord(box.min_x); x <= cell_coord(box.max_x); ++x) {
+                    cells_[cell_key(x, y)].push_back(index);
+                }
+            }
+        }
+    }
+
+    void collect_pairs(std::vector<CollisionPair>& pairs) override {
+        for (const auto& [key, cell] : cells_) {
+            if (cell.size() < 2) {
+                continue;
+            }
+            for (std::size_t i = 0; i < cell.size(); ++i) {
+                for (std::size_t j = i + 1; j < cell.size(); ++j) {
+                    const auto& a = entries_[cell[i]];
+                    const auto& b = entries_[cell[j]];
+                    if (!a.box.overlaps(b.box)) {
+                        continue;
+                    }
+
+                    // A pair sharing several cells is only reported from the cell
+                    // holding the lower corner of the overlap region
+                    const auto x = cell_coord(std::max(a.box.min_x, b.box.min_x));
+                    const auto y = cell_coord(std::max(a.box.min_y, b.box.min_y));
+                    if (cell_key(x, y) == key) {
+                        pairs.emplace_back(a.entity, b.entity);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Cells currently held in the map, occupied or kept from the previous frame.
+     */
+    [[nodiscard]] std::size_t get_cell_count() const noexcept {
+        return cells_.size();
+    }
+
+private:
+    [[nodiscard]] std::int32_t cell_coord(const float value) const noexcept {
+        return static_cast<std::int32_t>(std::floor(value / cell_size_));
+    }
+
+    static std::uint64_t cell_key(const std::int32_t x, const std::int32_t y) noexcept {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+};
+
+/**
+ * @brief Dynamic AABB tree with fat leaves.
+ *
+ * Leaves store the collider bounds enlarged by a margin, so colliders
+ * that move a little stay inside their leaf and cost nothing. The margin
+ * scales with the collider's size, and the fat box is stretched further
+ * along the collider's last displacement, so small slow colliders get
+ * tight leaves and fast ones are not reinserted every frame. A leaf is
+ * only reinserted once its collider escapes the fat bounds; insertion
+ * picks the sibling with the lowest perimeter cost and refits and
+ * rebalances the ancestors on the way back up. Node size adapts to the
+ * collider, so mixing tiny and huge radii does not degrade it.
+ *
+ * Each leaf also keeps its tight bounds: traversal prunes on fat boxes,
+ * but only pairs whose tight boxes overlap are reported.
+ */
+class DynamicAabbTree {
+public:
+    static constexpr std::int32_t NULL_NODE = -1;
+
+private:
+    struct Node {
+        Aabb box{};
+        Aabb tight{};  // Leaves only: the collider's exact bounds
+        ecs::Entity entity{ecs::INVALID_ENTITY};
+        std::int32_t parent{NULL_NODE};
+        std::int32_t child1{NULL_NODE};
+        std::int32_t child2{NULL_NODE};
+        std::int32_t height{-1};
+
+        [[nodiscard]] bool is_leaf() const noexcept {
+            return child1 == NULL_NODE;
+        }
+    };
+
+    std::vector<Node> nodes_{};
+    std::int32_t root_{NULL_NODE};
+    std::int32_t free_list_{NULL_NODE};
+    float margin_ratio_;
+    float min_margin_;
+    float prediction_;
+    std::vector<std::int32_t> stack_{};
+    std::vector<std::pair<std::int32_t, std::int32_t>> pair_stack_{};
+
+public:
+    /**
+     * @param margin_ratio Fat margin as a fraction of the collider's half extent
+     * @param min_margin Smallest fat margin, in world units
+     * @param prediction Frames of the last displacement the fat box is stretched by
+     */
+    explicit DynamicAabbTree(const float margin_ratio = 0.1f, const float min_margin = 0.25f, const float prediction = 2.0f)
+        : margin_ratio_(margin_ratio), min_margin_(min_margin), prediction_(prediction) {}
+
+    std::int32_t create_proxy(const Aabb& box, const ecs::Entity entity) {
+        const auto proxy = allocate_node();
+        nodes_[proxy].box = fatten(box, 0.0f, 0.0f);
+        nodes_[proxy].tight = box;
+        nodes_[proxy].entity = entity;
+        nodes_[proxy].height = 0;
+        insert_leaf(proxy);
+        return proxy;
+    }
+
+    void destroy_proxy(const std::int32_t proxy) {
+        remove_leaf(proxy);
+        free_node(proxy);
+    }
+
+    /**
+     * @brief Updates a proxy after its collider moved.
+     * @return True if the leaf had to be reinserted
+     */
+    bool move_proxy(const std::int32_t proxy, const Aabb& box) {
+        const auto previous = nodes_[proxy].tight;
+        nodes_[proxy].tight = box;
+        if (nodes_[proxy].box.contains(box)) {
+            return false;
+        }
+
+        remove_leaf(proxy);
+        nodes_[proxy].box = fatten(box, box.min_x - previous.min_x, box.min_y - previous.min_y);
+        insert_leaf(proxy);
+        return true;
+    }
+
+    [[nodiscard]] const Aabb& get_fat_box(const std::int32_t proxy) const noexcept {
+        return nodes_[proxy].box;
+    }
+
+    [[nodiscard]] const Aabb& get_tight_box(const std::int32_t proxy) const noexcept {
+        return nodes_[proxy].tight;
+    }
+
+    [[nodiscard]] std::int32_t get_height() const noexcept {
+        return root_ == NULL_NODE ? 0 : nodes_[root_].height;
+    }
+
+    /**
+     * @brief Calls callback(proxy) for every leaf whose fat box overlaps box.
+     */
+    template<typename Callback>
+    void query(const Aabb& box, Callback&& callback) {
+        stack_.clear();
+        if (root_ != NULL_NODE) {
+            stack_.push_back(root_);
+        }
+
+        while (!stack_.empty()) {
+            const auto index = stack_.back();
+            stack_.pop_back();
+
+            const auto& node = nodes_[index];
+            if (!node.box.overlaps(box)) {
+                continue;
+            }
+            if (node.is_leaf()) {
+                callback(index);
+            } else {
+                stack_.push_back(node.child1);
+                stack_.push_back(node.child2);
+            }
+        }
+    }
+
+    /**
+     * @brief Appends every pair of leaves with overlapping tight boxes.
+     *
+     * Descends the tree against itself: a subtree is paired with itself
+     * and with its sibling only, and two subtrees are only opened while
+     * their fat boxes overlap. Each pair is therefore visited once,
+     * without a query per leaf.
+     */
+    void collect_pairs(std::vector<CollisionPair>& pairs) {
+        pair_stack_.clear();
+        if (root_ != NULL_NODE) {
+            pair_stack_.emplace_back(root_, root_);
+        }
+
+        while (!pair_stack_.empty()) {
+            const auto [a, b] = pair_stack_.back();
+            pair_stack_.pop_back();
+
+            const auto& node_a = nodes_[a];
+            if (a == b) {
+                if (!node_a.is_leaf()) {
+                    pair_stack_.emplace_back(node_a.child1, node_a.child1);
+                    pair_stack_.emplace_back(node_a.child2, node_a.child2);
+                    pair_stack_.emplace_back(node_a.child1, node_a.child2);
+                }
+                continue;
+            }
+
+            const auto& node_b = nodes_[b];
+            if (!node_a.box.overlaps(node_b.box)) {
+                continue;
+            }
+            if (node_a.is_leaf() && node_b.is_leaf()) {
+                if (node_a.tight.overlaps(node_b.tight)) {
+                    pairs.emplace_back(node_a.entity, node_b.entity);
+                }
+            } else if (node_b.is_leaf() || (!node_a.is_leaf() && node_a.box.perimeter() >= node_b.box.perimeter())) {
+                // Open the larger subtree so the boxes compared stay of similar size
+                pair_stack_.emplace_back(node_a.child1, b);
+                pair_stack_.emplace_back(node_a.child2, b);
+            } else {
+                pair_stack_.emplace_back(a, node_b.child1);
+                pair_stack_.emplace_back(a, node_b.child2);
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Fat box of a leaf: a margin relative to its size, stretched along its displacement (dx, dy).
+     */
+    [[nodiscard]] Aabb fatten(const Aabb& box, const float dx, const float dy) const noexcept {
+        const float half_extent = 0.5f * std::max(box.max_x - box.min_x, box.max_y - box.min_y);
+        auto fat = box.fattened(std::max(min_margin_, margin_ratio_ * half_extent));
+        (dx < 0.0f ? fat.min_x : fat.max_x) += prediction_ * dx;
+        (dy < 0.0f ? fat.min_y : fat.max_y) += prediction_ * dy;
+        return fat;
+    }
+
+    std::int32_t allocate_node() {
+        std::int32_t index;
+        if (free_list_ == NULL_NODE) {
+            index = static_cast<std::int32_t>(nodes_.size());
+            nodes_.emplace_back();
+        } else {
+            index = free_list_;
+            free_list_ = nodes_[index].parent;
+            nodes_[index] = Node{};
+        }
+        return index;
+    }
+
+    void free_node(const std::int32_t index) {
+        nodes_[index].parent = free_list_;
+        nodes_[index].height = -1;
+        free_list_ = index;
+    }
+
+    void insert_leaf(const std::int32_t leaf) {
+        if (root_ == NULL_NODE) {
+            root_ = leaf;
+            nodes_[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        // Descend towards the sibling that grows the tree's total perimeter least
+        const auto leaf_box = nodes_[leaf].box;
+        auto index = root_;
+        while (!nodes_[index].is_leaf()) {
+            const auto& node = nodes_[index];
+            const float area = node.box.perimeter();
+            const float combined_area = Aabb::merge(node.box, leaf_box).perimeter();
+            const float cost = 2.0f * combined_area;
+            const float inheritance_cost = 2.0f * (combined_area - area);
+
+            const auto child_cost = [&](const std::int32_t child) {
+                const auto& child_node = nodes_[child];
+                const float merged = Aabb::merge(leaf_box, child_node.box).perimeter();
+                return (child_node.is_leaf() ? merged : merged - child_node.box.perimeter()) + inheritance_cost;
+            };
+
+            const float cost1 = child_cost(node.child1);
+            const float cost2 = child_cost(node.child2);
+            if (cost < cost1 && cost < cost2) {
+                break;
+            }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const auto sibling = index;
+        const auto old_parent = nodes_[sibling].parent;
+        const auto new_parent = allocate_node();
+        nodes_[new_parent].parent = old_parent;
+        nodes_[new_parent].box = Aabb::merge(leaf_box, nodes_[sibling].box);
+        nodes_[new_parent].height = nodes_[sibling].height + 1;
+        nodes_[new_parent].child1 = sibling;
+        nodes_[new_parent].child2 = leaf;
+        nodes_[sibling].parent = new_parent;
+        nodes_[leaf].parent = new_parent;
+
+        if (old_parent == NULL_NODE) {
+            root_ = new_parent;
+        } else if (nodes_[old_parent].child1 == sibling) {
+            nodes_[old_parent].child1 = new_parent;
+        } else {
+            nodes_[old_parent].child2 = new_parent;
+        }
+
+        refit_ancestors(nodes_[leaf].parent);
+    }
+
+    void remove_leaf(const std::int32_t leaf) {
+        if (leaf == root_) {
+            root_ = NULL_NODE;
+            return;
+        }
+
+        const auto parent = nodes_[leaf].parent;
+        const auto grand_parent = nodes_[parent].parent;
+        const auto sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+        if (grand_parent == NULL_NODE) {
+            root_ = sibling;
+            nodes_[sibling].parent = NULL_NODE;
+            free_node(parent);
+            return;
+        }
+
+        if (nodes_[grand_parent].child1 == parent) {
+            nodes_[grand_parent].child1 = sibling;
+        } else {
+            nodes_[grand_parent].child2 = sibling;
+        }
+        nodes_[sibling].parent = grand_parent;
+        free_node(parent);
+
+        refit_ancestors(grand_parent);
+    }
+
+    void refit_ancestors(std::int32_t index) {
+        while (index != NULL_NODE) {
+            index = balance(index);
+
+            auto& node = nodes_[index];
+            const auto& child1 = nodes_[node.child1];
+            const auto& child2 = nodes_[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.box = Aabb::merge(child1.box, child2.box);
+
+            index = node.parent;
+        }
+    }
+
+    /**
+     * @brief Rotates the taller grandchild up if a subtree is out of balance.
+     * @return Index of the node now at the subtree's root
+     */
+    std::int32_t balance(const std::int32_t a) {
+        if (nodes_[a].is_leaf() || nodes_[a].height < 2) {
+            return a;
+        }
+
+        const auto b = nodes_[a].child1;
+        const auto c = nodes_[a].child2;
+        const auto difference = nodes_[c].height - nodes_[b].height;
+
+        if (difference > 1) {
+            rotate_up(a, c, b, false);
+            return c;
+        }
+        if (difference < -1) {
+            rotate_up(a, b, c, true);
+            return b;
+        }
+        return a;
+    }
+
+    /**
+     * @brief Makes child the parent of a; a keeps other plus child's shorter subtree.
+     */
+    void rotate_up(const std::int32_t a, const std::int32_t child, const std::int32_t other, const bool child_is_first) {
+        const auto f = nodes_[child].child1;
+        const auto g = nodes_[child].child2;
+
+        nodes_[child].child1 = a;
+        nodes_[child].parent = nodes_[a].parent;
+        nodes_[a].parent = child;
+
+        if (nodes_[child].parent == NULL_NODE) {
+            root_ = child;
+        } else if (nodes_[nodes_[child].parent].child1 == a) {
+            nodes_[nodes_[child].parent].child1 = child;
+        } else {
+            nodes_[nodes_[child].parent].child2 = child;
+        }
+
+        const bool keep_f = nodes_[f].height > nodes_[g].height;
+        const auto kept = keep_f ? f : g;
+        const auto moved = keep_f ? g : f;
+
+        nodes_[child].child2 = kept;
+        if (child_is_first) {
+            nodes_[a].child1 = moved;
+        } else {
+            nodes_[a].child2 = moved;
+        }
+        nodes_[moved].parent = a;
+
+        nodes_[a].box = Aabb::merge(nodes_[other].box, nodes_[moved].box);
+        nodes_[child].box = Aabb::merge(nodes_[a].box, nodes_[kept].box);
+        nodes_[a].height = 1 + std::max(nodes_[other].height, nodes_[moved].height);
+        nodes_[child].height = 1 + std::max(nodes_[a].height, nodes_[kept].height);
+    }
+};
+
+/**
+ * @brief Broadphase backed by a DynamicAabbTree, keeping one proxy per collider.
+ */
+class AabbTreeBroadphase final : public Broadphase {
+    struct Proxy {
+        std::int32_t id{DynamicAabbTree::NULL_NODE};
+        std::uint64_t last_seen{0};
+    };
+
+    DynamicAabbTree tree_;
+    // Indexed by entity ID; tracked_ lists the IDs that currently have a proxy
+    std::vector<Proxy> proxies_ = std::vector<Proxy>(ecs::MAX_ENTITIES);
+    std::vector<ecs::Entity> tracked_{};
+    std::uint64_t frame_{0};
+
+public:
+    AabbTreeBroadphase() = default;
+    explicit AabbTreeBroadphase(DynamicAabbTree tree) : tree_(std::move(tree)) {}
+
+    void update(const ecs::World& world, const std::span<const ecs::Entity> entities) override {
+        ++frame_;
+        for (const auto entity : entities) {
+            const auto box = Aabb::from_circle(world.get_component<Position>(entity),
+                                               world.get_component<Collider>(entity));
+            auto& proxy = proxies_[entity];
+            if (proxy.id == DynamicAabbTree::NULL_NODE) {
+                proxy.id = tree_.create_proxy(box, entity);
+                tracked_.push_back(entity);
+            } else {
+                tree_.move_proxy(proxy.id, box);
+            }
+            proxy.last_seen = frame_;
+        }
+
+        // Drop proxies of colliders that were removed since last frame
+        std::erase_if(tracked_, [&](const ecs::Entity entity) {
+            auto& proxy = proxies_[entity];
+            if (proxy.last_seen == frame_) {
+                return false;
+            }
+            tree_.destroy_proxy(proxy.id);
+            proxy = Proxy{};
+            return true;
+        });
+    }
+
+    void collect_pairs(std::vector<CollisionPair>& pairs) override {
+        tree_.collect_pairs(pairs);
+    }
+
+    [[nodiscard]] const DynamicAabbTree& get_tree() const noexcept {
+        return tree_;
+    }
+};
+
+} // namespace example
+} // namespace game
+
+#endif // GAME_EXAMPLE_BROADPHASE_HPP
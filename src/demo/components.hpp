@@ -1,6 +1,8 @@
 #ifndef GAME_EXAMPLE_COMPONENTS_HPP
 #define GAME_EXAMPLE_COMPONENTS_HPP
 
+#include "ecs/cold_storage_array.hpp"
+#include "ecs/reflection.hpp"
 #include <string>
 
 namespace game {
@@ -128,4 +130,21 @@ struct Collider {
 } // namespace example
 } // namespace game
 
+ECS_REFLECT(game::example::Position, x, y)
+ECS_REFLECT(game::example::Velocity, dx, dy)
+ECS_REFLECT(game::example::Sprite, texture_name, width, height)
+ECS_REFLECT(game::example::Health, current, maximum)
+ECS_REFLECT(game::example::PlayerControlled, move_speed)
+ECS_REFLECT(game::example::AIControlled, patrol_range, detection_radius, home_position)
+ECS_REFLECT(game::example::Damage, amount, destroy_on_hit)
+ECS_REFLECT(game::example::Lifetime, remaining_time)
+ECS_REFLECT(game::example::Collectible, score_value, pickup_sound)
+ECS_REFLECT(game::example::Collider, radius, is_trigger)
+
+// Position is not double-buffered: movement, AI and collision all run on the main thread
+// and must see this frame's values, and rendering reads a FramePipeline snapshot instead
+
+// AI settings are written once at spawn; pages of dormant AI entities get compressed
+ECS_COLD_STORAGE(game::example::AIControlled)
+
 #endif // GAME_EXAMPLE_COMPONENTS_HPP 
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef GAME_EXAMPLE_CONTACTS_HPP
+#define GAME_EXAMPLE_CONTACTS_HPP
+
+#include "ecs/entity_bitset.hpp"
+#include "broadphase.hpp"
+#include "events.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+namespace example {
+
+/**
+ * @brief Hash for entity pairs, used to key persistent contacts.
+ */
+struct CollisionPairHash {
+    std::size_t operator()(const CollisionPair& pair) const noexcept {
+        return std::hash<std::uint64_t>{}(pair.first * 0x9e3779b97f4a7c15ULL ^ pair.second);
+    }
+};
+
+/**
+ * @brief Tracks which pairs are touching across frames.
+ *
+ * Each frame's contact list is folded into a hash map keyed by the
+ * entity pair: new pairs are reported as Enter, pairs seen last frame
+ * as Stay, and pairs that were not seen this frame as Exit before they
+ * are dropped. Exits are sorted so the transition list is deterministic.
+ *
+ * Entity IDs are recycled, so the owner must call forget() when an
+ * entity is destroyed or stops colliding. Its pairs then end with an
+ * Exit on the next update(), even if a new entity with the same ID
+ * touches the same partner, which is reported as a fresh Enter.
+ */
+class ContactTracker {
+public:
+    struct Transition {
+        CollisionPair pair{};
+        ContactPhase phase{ContactPhase::Enter};
+    };
+
+private:
+    std::unordered_map<CollisionPair, std::uint64_t, CollisionPairHash> last_seen_{};
+    std::vector<CollisionPair> exits_{};
+    ecs::EntityMask forgotten_{};
+    std::vector<ecs::Entity> forgotten_list_{};
+    std::uint64_t frame_{0};
+
+public:
+    /**
+     * @brief Ends every contact of an entity whose ID may be reused.
+     */
+    void forget(const ecs::Entity entity) {
+        if (!forgotten_.test(entity)) {
+            forgotten_.set(entity);
+            forgotten_list_.push_back(entity);
+        }
+    }
+
+    /**
+     * @brief Updates the contact set and appends this frame's transitions.
+     * @param contacts Pairs overlapping this frame, in deterministic order
+     * @param transitions Output: sorted Exits of forgotten entities, Enter/Stay in contact order, then other sorted Exits
+     */
+    void update(const std::span<const CollisionPair> contacts, std::vector<Transition>& transitions) {
+        ++frame_;
+
+        // Contacts of forgotten IDs end before the contacts of this frame are matched
+        if (!forgotten_list_.empty()) {
+            exits_.clear();
+            std::erase_if(last_seen_, [&](const auto& entry) {
+                if (!forgotten_.test(entry.first.first) && !forgotten_.test(entry.first.second)) {
+                    return false;
+                }
+                exits_.push_back(entry.first);
+                return true;
+            });
+            for (const auto entity : forgotten_list_) {
+                forgotten_.reset(entity);
+            }
+            forgotten_list_.clear();
+
+            std::sort(exits_.begin(), exits_.end());
+            for (const auto& exit : exits_) {
+                transitions.push_back({exit, ContactPhase::Exit});
+            }
+        }
+
+        for (const auto& contact : contacts) {
+            auto [it, inserted] = last_seen_.try_emplace(contact, frame_);
+            it->second = frame_;
+            transitions.push_back({contact, inserted ? ContactPhase::Enter : ContactPhase::Stay});
+        }
+
+        exits_.clear();
+        std::erase_if(last_seen_, [&](const auto& entry) {
+            if (entry.second == frame_) {
+                return false;
+            }
+            exits_.push_back(entry.first);
+            return true;
+        });
+
+        std::sort(exits_.begin(), exits_.end());
+        for (const auto& exit : exits_) {
+            transitions.push_back({exit, ContactPhase::Exit});
+        }
+    }
+
+    [[nodiscard]] bool is_touching(const CollisionPair& pair) const noexcept {
+        return last_seen_.contains(pair);
+    }
+
+    [[nodiscard]] std::size_t get_contact_count() const noexcept {
+        return last_seen_.size();
+    }
+};
+
+} // namespace example
+} // namespace game
+
+#endif // GAME_EXAMPLE_CONTACTS_HPP
@@ -0,0 +1,35 @@
+#ifndef GAME_EXAMPLE_EVENTS_HPP
+#define GAME_EXAMPLE_EVENTS_HPP
+
+#include "ecs/entity.hpp"
+
+namespace game {
+namespace example {
+
+/**
+ * @brief Stage of a contact between two colliders.
+ */
+enum class ContactPhase {
+    Enter,  // Started touching this frame
+    Stay,   // Was already touching last frame
+    Exit    // Stopped touching (or one side was destroyed)
+};
+
+/**
+ * @brief Event emitted for every contact transition between two colliders.
+ */
+struct CollisionEvent {
+    ecs::Entity first{ecs::INVALID_ENTITY};
+    ecs::Entity second{ecs::INVALID_ENTITY};
+    ContactPhase phase{ContactPhase::Enter};
+    bool is_trigger{false};  // True if either collider is a trigger
+
+    CollisionEvent() = default;
+    CollisionEvent(ecs::Entity a, ecs::Entity b, ContactPhase phase = ContactPhase::Enter, bool trigger = false)
+        : first(a), second(b), phase(phase), is_trigger(trigger) {}
+};
+
+} // namespace example
+} // namespace game
+
+#endif // GAME_EXAMPLE_EVENTS_HPP 
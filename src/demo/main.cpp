@@ -1,5 +1,9 @@
+#include "ecs/frame_pipeline.hpp"
+#include "ecs/job_system.hpp"
+#include "ecs/static_system.hpp"
 #include "ecs/world.hpp"
 #include "components.hpp"
+#include "events.hpp"
 #include "systems.hpp"
 #include <iostream>
 #include <chrono>
@@ -15,7 +19,7 @@ int main() {
     World world;
 
     // Step 1: Register all component types
-    std::cout << "1. Registering components...\n";
+    std::cout << "1. Registering components and events...\n";
     world.register_component<Position>();
     world.register_component<Velocity>();
     world.register_component<Sprite>();
@@ -26,28 +30,47 @@ int main() {
     world.register_component<Lifetime>();
     world.register_component<Collectible>();
     world.register_component<Collider>();
+    world.register_event<CollisionEvent>();
 
     // Step 2: Register and configure systems
     std::cout << "2. Registering systems...\n";
-    auto& movement_system = world.register_system<MovementSystem>(&world);
-    auto& render_system = world.register_system<RenderSystem>(&world);
     auto& player_input_system = world.register_system<PlayerInputSystem>(&world);
     auto& ai_system = world.register_system<AISystem>(&world);
     auto& health_system = world.register_system<HealthSystem>(&world);
     auto& lifetime_system = world.register_system<LifetimeSystem>(&world);
     auto& collision_system = world.register_system<CollisionSystem>(&world);
+    auto& damage_system = world.register_system<DamageSystem>(&world);
+    auto& pickup_system = world.register_system<PickupSystem>(&world);
 
     // Step 3: Set system signatures (which components each system requires)
     std::cout << "3. Setting system signatures...\n";
     
     // Each system signature is defined by the component types it requires
-    world.set_system_signature<MovementSystem, Position, Velocity>();
-    world.set_system_signature<RenderSystem, Position, Sprite>();
     world.set_system_signature<PlayerInputSystem, Position, Velocity, PlayerControlled>();
     world.set_system_signature<AISystem, Position, Velocity, AIControlled>();
     world.set_system_signature<HealthSystem, Health>();
     world.set_system_signature<LifetimeSystem, Lifetime>();
     world.set_system_signature<CollisionSystem, Position, Collider>();
+    // DamageSystem and PickupSystem only consume collision events, so they track no entities
+
+    // Declared access lets schedulers group systems and ECS_ACCESS_AUDIT builds check them
+    world.set_system_access<PlayerInputSystem, Reads<PlayerControlled>, Writes<Velocity>>();
+    world.set_system_access<AISystem, Reads<Position, AIControlled>, Writes<Velocity>>();
+    world.set_system_access<HealthSystem, Reads<Health>>();
+    world.set_system_access<LifetimeSystem, Reads<>, Writes<Lifetime>>();
+    world.set_system_access<CollisionSystem, Reads<Position, Collider>>();
+    world.set_system_access<DamageSystem, Reads<Damage>, Writes<Health>>();
+    world.set_system_access<PickupSystem, Reads<Collectible, PlayerControlled>>();
+
+    // Rendering only reads the finished frame, so it runs on a snapshot
+    // while the next frame is simulated
+    JobSystem jobs(2);
+    FramePipeline pipeline(world, jobs);
+    pipeline.capture_components<Position, Sprite>();
+    auto& render_system = pipeline.add_system<RenderSystem>();
+
+    // Hot systems with compile-time signatures run with static dispatch
+    StaticSystemGroup hot_systems{MovementSystem{}};
 
     // Step 4: Create entities with different component combinations
     std::cout << "4. Creating entities...\n";
@@ -109,6 +132,7 @@ int main() {
     
     int frame_count = 0;
     const int max_frames = 300;  // Run for ~5 seconds at 60 FPS
+    float session_time = 0.0f;
 
     while (frame_count < max_frames) {
         auto current_time = std::chrono::high_resolution_clock::now();
@@ -119,8 +143,13 @@ int main() {
             delta = frame_time;
         }
 
-        // Update all systems
-        world.tick(delta);
+        // Simulated device input; replay_demo records and replays the same stream
+        session_time += delta;
+        player_input_system.set_input(figure_eight_input(session_time));
+
+        // Update all systems; rendering of this frame overlaps the next one
+        hot_systems.tick(world, delta);
+        pipeline.tick(delta);
 
         // Print frame info every second
         if (frame_count % 60 == 0) {
@@ -135,10 +164,18 @@ int main() {
         frame_count++;
     }
 
+    pipeline.flush();
     std::cout << "\n=== Simulation Complete ===\n";
     std::cout << "Final entity count: " << world.get_entity_count() << "\n";
     std::cout << "Total frames processed: " << frame_count << "\n";
 
+    // Component fields are printed through their reflection metadata
+    std::cout << "Player state: ";
+    dump(std::cout, world.get_component<Position>(player));
+    std::cout << " ";
+    dump(std::cout, world.get_component<Health>(player));
+    std::cout << "\n";
+
     std::cout << "\n=== Example Summary ===\n";
     std::cout << "This example demonstrated:\n";
     std::cout << "• Component registration and type management\n";
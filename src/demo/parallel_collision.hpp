@@ -0,0 +1,362 @@
+#ifndef GAME_EXAMPLE_PARALLEL_COLLISION_HPP
+#define GAME_EXAMPLE_PARALLEL_COLLISION_HPP
+
+#include "ecs/cache.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/job_system.hpp"
+#include "ecs/world.hpp"
+#include "broadphase.hpp"
+#include "components.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace game {
+namespace example {
+
+/**
+ * @brief Uniform grid broadphase and circle narrow phase split into parallel stages.
+ *
+ * Per frame:
+ *  1. colliders are snapshotted into SoA arrays and the grid bounds are
+ *     reduced per worker;
+ *  2. every collider writes its (cell, collider) records into a slot
+ *     reserved by a prefix sum, and the records are sorted by cell with a
+ *     parallel merge sort, which lays the grid out as contiguous runs;
+ *  3. cells are handed out to workers, each testing the pairs of a cell
+ *     (AABB, then circle) into its own contact buffer;
+ *  4. buffers are merged into one list through an atomic cursor and
+ *     sorted.
+ *
+ * Every pair is reported by exactly one cell and the final list is
+ * sorted, so the result is identical for any worker count. Stages run
+ * on the caller's JobSystem, shared with the rest of the frame, so
+ * find_contacts() must run on its owning thread or one of its workers.
+ * With a single worker, or on a single hardware thread, the stages run
+ * inline on the calling thread instead, and a dense grid is sorted by a
+ * counting pass: splitting work into jobs there only adds overhead.
+ */
+class ParallelCollisionPipeline {
+    struct CellRecord {
+        std::uint64_t cell;
+        std::uint32_t collider;
+
+        bool operator<(const CellRecord& other) const noexcept {
+            return cell != other.cell ? cell < other.cell : collider < other.collider;
+        }
+    };
+
+    struct Bounds {
+        float min_x{std::numeric_limits<float>::max()};
+        float min_y{std::numeric_limits<float>::max()};
+        float max_x{std::numeric_limits<float>::lowest()};
+        float max_y{std::numeric_limits<float>::lowest()};
+    };
+
+    // Written by one worker each; padded so neighbours never share a cache line
+    struct alignas(ecs::CACHE_LINE_SIZE) WorkerScratch {
+        Bounds bounds{};
+        std::vector<CollisionPair> contacts{};
+    };
+
+    // Chunks of per-collider arrays end on cache lines, so neighbouring workers never write the same line
+    static constexpr std::size_t COLLIDER_GRAIN = ecs::cache_aligned_grain<std::uint32_t>(1000);
+    static constexpr std::size_t CELL_GRAIN = 256;
+    static constexpr std::size_t MIN_SORT_RUN = 4096;
+    // Inline mode counting-sorts records while the grid has at most this many cells per record
+    static constexpr std::size_t DENSE_GRID_RATIO = 4;
+
+    ecs::JobSystem& jobs_;
+    float cell_size_;
+    bool serial_;
+
+    std::vector<ecs::Entity> entities_{};
+    std::vector<float> x_{};
+    std::vector<float> y_{};
+    std::vector<float> radius_{};
+
+    Bounds bounds_{};
+    std::uint64_t columns_{1};
+    ecs::CacheAlignedVector<std::uint32_t> record_offsets_{};
+    ecs::CacheAlignedVector<CellRecord> records_{};
+    ecs::CacheAlignedVector<CellRecord> record_scratch_{};
+    std::vector<std::uint32_t> cell_starts_{};
+    std::vector<std::uint32_t> cell_counts_{};
+
+    std::vector<WorkerScratch> workers_;
+    std::atomic<std::size_t> contact_cursor_{0};
+    ecs::CacheAlignedVector<CollisionPair> contacts_{};
+    ecs::CacheAlignedVector<CollisionPair> contact_scratch_{};
+
+public:
+    explicit ParallelCollisionPipeline(ecs::JobSystem& jobs, const float cell_size = 64.0f)
+        : jobs_(jobs),
+          cell_size_(cell_size),
+          serial_(jobs_.get_worker_count() == 1 || std::thread::hardware_concurrency() == 1),
+          workers_(serial_ ? 1 : jobs_.get_worker_count()) {}
+
+    /**
+     * @brief Number of workers the stages are split across; 1 when they run inline.
+     */
+    [[nodiscard]] std::size_t get_worker_count() const noexcept {
+        return workers_.size();
+    }
+
+    void clear() noexcept {
+        entities_.clear();
+        x_.clear();
+        y_.clear();
+        radius_.clear();
+    }
+
+    void add_collider(const ecs::Entity entity, const float x, const float y, const float radius) {
+        entities_.push_back(entity);
+        x_.push_back(x);
+        y_.push_back(y);
+        radius_.push_back(radius);
+    }
+
+    /**
+     * @brief Replaces the collider snapshot with Position + Collider of entities.
+     */
+    void gather(const ecs::World& world, const std::span<const ecs::Entity> entities) {
+        clear();
+        for (const auto entity : entities) {
+            const auto& position = world.get_component<Position>(entity);
+            add_collider(entity, position.x, position.y, world.get_component<Collider>(entity).radius);
+        }
+    }
+
+    /**
+     * @brief Appends every overlapping pair of the snapshot, sorted.
+     */
+    void find_contacts(std::vector<CollisionPair>& contacts) {
+        if (entities_.size() < 2) {
+            return;
+        }
+
+        compute_bounds();
+        build_grid();
+        test_cells();
+        merge_contacts();
+
+        contacts.insert(contacts.end(), contacts_.begin(), contacts_.end());
+    }
+
+private:
+    void compute_bounds() {
+        for (auto& worker : workers_) {
+            worker.bounds = Bounds{};
+        }
+
+        for_range(entities_.size(), COLLIDER_GRAIN, [this](auto begin, auto end, auto worker) {
+            auto& bounds = workers_[worker].bounds;
+            for (auto i = begin; i < end; ++i) {
+                bounds.min_x = std::min(bounds.min_x, x_[i] - radius_[i]);
+                bounds.min_y = std::min(bounds.min_y, y_[i] - radius_[i]);
+                bounds.max_x = std::max(bounds.max_x, x_[i] + radius_[i]);
+                bounds.max_y = std::max(bounds.max_y, y_[i] + radius_[i]);
+            }
+        });
+
+        bounds_ = Bounds{};
+        for (const auto& worker : workers_) {
+            bounds_.min_x = std::min(bounds_.min_x, worker.bounds.min_x);
+            bounds_.min_y = std::min(bounds_.min_y, worker.bounds.min_y);
+            bounds_.max_x = std::max(bounds_.max_x, worker.bounds.max_x);
+            bounds_.max_y = std::max(bounds_.max_y, worker.bounds.max_y);
+        }
+        columns_ = static_cast<std::uint64_t>(cell_coord(bounds_.max_x, bounds_.min_x)) + 1;
+    }
+
+    void build_grid() {
+        const auto count = entities_.size();
+        record_offsets_.resize(count + 1);
+
+        // Count the cells each collider covers, then prefix-sum into write slots
+        for_range(count, COLLIDER_GRAIN, [this](auto begin, auto end, auto) {
+            for (auto i = begin; i < end; ++i) {
+                const auto columns = cell_coord(x_[i] + radius_[i], bounds_.min_x) - cell_coord(x_[i] - radius_[i], bounds_.min_x) + 1;
+                const auto rows = cell_coord(y_[i] + radius_[i], bounds_.min_y) - cell_coord(y_[i] - radius_[i], bounds_.min_y) + 1;
+                record_offsets_[i] = columns * rows;
+            }
+        });
+        std::uint32_t total = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto cells = record_offsets_[i];
+            record_offsets_[i] = total;
+            total += cells;
+        }
+        record_offsets_[count] = total;
+
+        records_.resize(record_offsets_[count]);
+        for_range(count, COLLIDER_GRAIN, [this](auto begin, auto end, auto) {
+            for (auto i = begin; i < end; ++i) {
+                auto slot = record_offsets_[i];
+                for (auto y = cell_coord(y_[i] - radius_[i], bounds_.min_y); y <= cell_coord(y_[i] + radius_[i], bounds_.min_y); ++y) {
+                    for (auto x = cell_coord(x_[i] - radius_[i], bounds_.min_x); x <= cell_coord(x_[i] + radius_[i], bounds_.min_x); ++x) {
+                        records_[slot++] = {cell_key(x, y), static_cast<std::uint32_t>(i)};
+                    }
+                }
+            }
+        });
+
+        // Records are in collider order, so a stable scatter by cell sorts them fully
+        const auto cells = columns_ * (static_cast<std::uint64_t>(cell_coord(bounds_.max_y, bounds_.min_y)) + 1);
+        if (serial_ && cells <= records_.size() * DENSE_GRID_RATIO) {
+            counting_sort(cells);
+        } else {
+            parallel_sort(records_, record_scratch_);
+        }
+
+        cell_starts_.clear();
+        for (std::size_t i = 0; i < records_.size(); ++i) {
+            if (i == 0 || records_[i].cell != records_[i - 1].cell) {
+                cell_starts_.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        cell_starts_.push_back(static_cast<std::uint32_t>(records_.size()));
+    }
+
+    void test_cells() {
+        for (auto& worker : workers_) {
+            worker.contacts.clear();
+        }
+
+        for_range(cell_starts_.size() - 1, CELL_GRAIN, [this](auto begin, auto end, auto worker) {
+            auto& contacts = workers_[worker].contacts;
+            for (auto cell = begin; cell < end; ++cell) {
+                test_cell(cell_starts_[cell], cell_starts_[cell + 1], contacts);
+            }
+        });
+    }
+
+    void test_cell(const std::uint32_t begin, const std::uint32_t end, std::vector<CollisionPair>& contacts) const {
+        const auto key = records_[begin].cell;
+        for (auto i = begin; i < end; ++i) {
+            const auto a = records_[i].collider;
+            for (auto j = i + 1; j < end; ++j) {
+                const auto b = records_[j].collider;
+
+                const float dx = x_[a] - x_[b];
+                const float dy = y_[a] - y_[b];
+                const float reach = radius_[a] + radius_[b];
+                if (dx * dx + dy * dy >= reach * reach) {
+                    continue;
+                }
+
+                // A pair sharing several cells is only reported from the cell
+                // holding the lower corner of the overlap of their bounds
+                const auto x = cell_coord(std::max(x_[a] - radius_[a], x_[b] - radius_[b]), bounds_.min_x);
+                const auto y = cell_coord(std::max(y_[a] - radius_[a], y_[b] - radius_[b]), bounds_.min_y);
+                if (cell_key(x, y) == key) {
+                    contacts.emplace_back(entities_[a], entities_[b]);
+                }
+            }
+        }
+    }
+
+    void merge_contacts() {
+        std::size_t total = 0;
+        for (const auto& worker : workers_) {
+            total += worker.contacts.size();
+        }
+        contacts_.resize(total);
+        contact_cursor_.store(0, std::memory_order_relaxed);
+
+        // Each worker reserves a range of the shared list and copies without locking
+        for_range(workers_.size(), 1, [this](auto begin, auto end, auto) {
+            for (auto i = begin; i < end; ++i) {
+                const auto& local = workers_[i].contacts;
+                const auto offset = contact_cursor_.fetch_add(local.size(), std::memory_order_relaxed);
+                std::copy(local.begin(), local.end(), contacts_.begin() + static_cast<std::ptrdiff_t>(offset));
+            }
+        });
+
+        // Range order depends on scheduling; sorting restores a fixed order
+        parallel_sort(contacts_, contact_scratch_);
+    }
+
+    /**
+     * @brief Sorts records_ by cell in one counting pass over the whole grid.
+     */
+    void counting_sort(const std::uint64_t cells) {
+        cell_counts_.assign(cells + 1, 0);
+        for (const auto& record : records_) {
+            ++cell_counts_[record.cell + 1];
+        }
+        for (std::uint64_t cell = 0; cell < cells; ++cell) {
+            cell_counts_[cell + 1] += cell_counts_[cell];
+        }
+
+        record_scratch_.resize(records_.size());
+        for (const auto& record : records_) {
+            record_scratch_[cell_counts_[record.cell]++] = record;
+        }
+        records_.swap(record_scratch_);
+    }
+
+    /**
+     * @brief Sorts runs in parallel, then merges neighbouring runs pairwise in parallel rounds.
+     */
+    template<typename Vector>
+    void parallel_sort(Vector& values, Vector& scratch) {
+        const auto count = values.size();
+        const auto run = std::max(MIN_SORT_RUN, (count + workers_.size() - 1) / workers_.size());
+        const auto runs = (count + run - 1) / run;
+
+        for_range(runs, 1, [&](auto begin, auto end, auto) {
+            for (auto r = begin; r < end; ++r) {
+                std::sort(values.begin() + static_cast<std::ptrdiff_t>(r * run),
+                          values.begin() + static_cast<std::ptrdiff_t>(std::min(count, (r + 1) * run)));
+            }
+        });
+
+        scratch.resize(count);
+        for (auto width = run; width < count; width *= 2) {
+            for_range((count + 2 * width - 1) / (2 * width), 1, [&](auto begin, auto end, auto) {
+                for (auto m = begin; m < end; ++m) {
+                    const auto lo = static_cast<std::ptrdiff_t>(m * 2 * width);
+                    const auto mid = static_cast<std::ptrdiff_t>(std::min(count, m * 2 * width + width));
+                    const auto hi = static_cast<std::ptrdiff_t>(std::min(count, (m + 1) * 2 * width));
+                    std::merge(values.begin() + lo, values.begin() + mid,
+                               values.begin() + mid, values.begin() + hi, scratch.begin() + lo);
+                }
+            });
+            values.swap(scratch);
+        }
+    }
+
+    /**
+     * @brief JobSystem::parallel_for(), or one inline call on worker 0 in serial mode.
+     */
+    template<typename F>
+    void for_range(const std::size_t count, const std::size_t grain, F&& body) {
+        if (serial_) {
+            if (count > 0) {
+                body(std::size_t{0}, count, std::size_t{0});
+            }
+            return;
+        }
+        jobs_.parallel_for(count, grain, std::forward<F>(body));
+    }
+
+    [[nodiscard]] std::uint32_t cell_coord(const float value, const float origin) const noexcept {
+        return static_cast<std::uint32_t>(std::floor((value - origin) / cell_size_));
+    }
+
+    [[nodiscard]] std::uint64_t cell_key(const std::uint32_t x, const std::uint32_t y) const noexcept {
+        return static_cast<std::uint64_t>(y) * columns_ + x;
+    }
+};
+
+} // namespace example
+} // namespace game
+
+#endif // GAME_EXAMPLE_PARALLEL_COLLISION_HPP
@@ -0,0 +1,210 @@
+#include "ecs/replay.hpp"
+#include "ecs/static_system.hpp"
+#include "ecs/world.hpp"
+#include "ecs/world_digest.hpp"
+#include "components.hpp"
+#include "events.hpp"
+#include "systems.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+
+using namespace game::ecs;
+using namespace game::example;
+
+namespace {
+
+constexpr std::uint32_t PLAYER_INPUT_CHANNEL = 0;
+constexpr std::size_t TICK_COUNT = 600;
+constexpr float TICK_DELTA = 1.0f / 60.0f;
+
+/**
+ * @brief The example's world and scene without rendering, built the same way for every run.
+ */
+class DemoSession {
+    World world_;
+    PlayerInputSystem* player_input_{nullptr};
+    StaticSystemGroup<MovementSystem> hot_systems_{MovementSystem{}};
+    ChangeChecksum checksum_{world_};
+    WorldDigest digest_{world_};
+
+public:
+    DemoSession() {
+        world_.register_component<Position>();
+        world_.register_component<Velocity>();
+        world_.register_component<Sprite>();
+        world_.register_component<Health>();
+        world_.register_component<PlayerControlled>();
+        world_.register_component<AIControlled>();
+        world_.register_component<Damage>();
+        world_.register_component<Lifetime>();
+        world_.register_component<Collectible>();
+        world_.register_component<Collider>();
+        world_.register_event<CollisionEvent>();
+
+        player_input_ = &world_.register_system<PlayerInputSystem>(&world_);
+        (void)world_.register_system<AISystem>(&world_);
+        (void)world_.register_system<HealthSystem>(&world_);
+        (void)world_.register_system<LifetimeSystem>(&world_);
+        (void)world_.register_system<CollisionSystem>(&world_);
+        (void)world_.register_system<DamageSystem>(&world_);
+        (void)world_.register_system<PickupSystem>(&world_);
+
+        world_.set_system_signature<PlayerInputSystem, Position, Velocity, PlayerControlled>();
+        world_.set_system_signature<AISystem, Position, Velocity, AIControlled>();
+        world_.set_system_signature<HealthSystem, Health>();
+        world_.set_system_signature<LifetimeSystem, Lifetime>();
+        world_.set_system_signature<CollisionSystem, Position, Collider>();
+
+        // Damage and Collider have padding bytes, so only their adds and removes are stamped
+        checksum_.track<Position>();
+        checksum_.track<Velocity>();
+        checksum_.track<Health>();
+        checksum_.track<Lifetime>();
+        digest_.track<Position>();
+        digest_.track<Velocity>();
+        digest_.track<Health>();
+        digest_.track<Lifetime>();
+
+        const auto player = world_.add_entity();
+        world_.add_component(player, Position{100.0f, 100.0f});
+        world_.add_component(player, Velocity{0.0f, 0.0f});
+        world_.add_component(player, Sprite{"player.png", 32, 32});
+        world_.add_component(player, Health{100, 100});
+        world_.add_component(player, PlayerControlled{80.0f});
+        world_.add_component(player, Collider{16.0f});
+
+        const auto enemy = world_.add_entity();
+        world_.add_component(enemy, Position{200.0f, 150.0f});
+        world_.add_component(enemy, Velocity{0.0f, 0.0f});
+        world_.add_component(enemy, Sprite{"enemy.png", 24, 24});
+        world_.add_component(enemy, Health{50, 50});
+        world_.add_component(enemy, AIControlled{100.0f, 80.0f, Position{200.0f, 150.0f}});
+        world_.add_component(enemy, Collider{12.0f});
+        world_.add_component(enemy, Damage{25, false});
+
+        const auto coin = world_.add_entity();
+        world_.add_component(coin, Position{150.0f, 200.0f});
+        world_.add_component(coin, Sprite{"coin.png", 16, 16});
+        world_.add_component(coin, Collectible{50, "coin_pickup.wav"});
+        world_.add_component(coin, Collider{8.0f, true});
+
+        const auto projectile = world_.add_entity();
+        world_.add_component(projectile, Position{80.0f, 80.0f});
+        world_.add_component(projectile, Velocity{120.0f, 60.0f});
+        world_.add_component(projectile, Sprite{"bullet.png", 8, 8});
+        world_.add_component(projectile, Damage{15, true});
+        world_.add_component(projectile, Lifetime{3.0f});
+        world_.add_component(projectile, Collider{4.0f});
+
+        const auto tree = world_.add_entity();
+        world_.add_component(tree, Position{300.0f, 250.0f});
+        world_.add_component(tree, Sprite{"tree.png", 48, 64});
+    }
+
+    /**
+     * @brief Runs one tick with the given input, in the order the example's main loop uses.
+     * @return The checksum up to and including this tick
+     */
+    std::uint64_t tick(const float delta, const PlayerInput& input) {
+        player_input_->set_input(input);
+        hot_systems_.tick(world_, delta);
+        world_.tick(delta);
+        return checksum_.end_tick();
+    }
+
+    /**
+     * @brief Digest of the tracked components as they are now.
+     */
+    [[nodiscard]] std::uint64_t get_digest() const noexcept {
+        return digest_.get_digest();
+    }
+
+    /**
+     * @brief Replays a recording on this session, which must not have ticked yet.
+     */
+    ReplayDriver::Result replay(ReplayDriver& driver) {
+        return driver.run(world_, checksum_, [this](const ReplayTick& tick) {
+            PlayerInput input;
+            tick.read_input(PLAYER_INPUT_CHANNEL, input);
+            player_input_->set_input(input);
+            // Static systems run outside World::tick(), so they go before it here too
+            hot_systems_.tick(world_, tick.delta);
+        });
+    }
+};
+
+}
+
+/**
+ * Records a headless session of the example, saves and reloads it, and
+ * replays it on a fresh world. The replay must match tick for tick; a
+ * replay with one input altered must diverge at exactly that tick.
+ */
+int main() {
+    const auto path = std::filesystem::temp_directory_path() / "ecs_replay_demo.rpl";
+
+    std::cout << "Recording " << TICK_COUNT << " ticks...\n";
+    ReplayRecorder recorder;
+    std::uint64_t recorded_digest = 0;
+    {
+        DemoSession session;
+        float time = 0.0f;
+        for (std::size_t i = 0; i < TICK_COUNT; ++i) {
+            time += TICK_DELTA;
+            const auto input = figure_eight_input(time);
+
+            recorder.begin_tick(TICK_DELTA, 0);
+            recorder.record_input(PLAYER_INPUT_CHANNEL, input);
+            recorder.end_tick(session.tick(TICK_DELTA, input));
+        }
+        recorded_digest = session.get_digest();
+    }
+
+    ReplayDriver driver;
+    if (!recorder.save(path) || !driver.load(path)) {
+        std::cout << "Could not save and reload the recording at " << path << "\n";
+        return 1;
+    }
+    std::filesystem::remove(path);
+
+    std::cout << "Replaying...\n";
+    const auto start = std::chrono::steady_clock::now();
+    ReplayDriver::Result result;
+    std::uint64_t replayed_digest = 0;
+    {
+        DemoSession session;
+        result = session.replay(driver);
+        replayed_digest = session.get_digest();
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (result.first_desync_tick) {
+        std::cout << "Replay desynced at tick " << *result.first_desync_tick << "\n";
+        return 1;
+    }
+    if (replayed_digest != recorded_digest) {
+        std::cout << "Replay matched every checksum but ended with a different world digest\n";
+        return 1;
+    }
+    std::cout << "Replayed " << result.ticks_run << " ticks in " << elapsed.count() << " ms without desync\n";
+
+    // A replay fed one different input must be caught on that tick
+    constexpr std::size_t ALTERED_TICK = TICK_COUNT / 2;
+    auto altered_ticks = driver.get_ticks();
+    altered_ticks[ALTERED_TICK].inputs.front().bytes.assign(sizeof(PlayerInput), std::byte{0});
+    ReplayDriver altered(std::move(altered_ticks));
+    ReplayDriver::Result altered_result;
+    {
+        DemoSession session;
+        altered_result = session.replay(altered);
+    }
+
+    if (altered_result.first_desync_tick != ALTERED_TICK) {
+        std::cout << "Altered input at tick " << ALTERED_TICK << " was not detected there\n";
+        return 1;
+    }
+    std::cout << "Altered input detected at tick " << ALTERED_TICK << "\n";
+    return 0;
+}
@@ -1,11 +1,23 @@
 #ifndef GAME_EXAMPLE_SYSTEMS_HPP
 #define GAME_EXAMPLE_SYSTEMS_HPP
 
+#include "ecs/frame_pipeline.hpp"
+#include "ecs/static_system.hpp"
 #include "ecs/system.hpp"
 #include "ecs/world.hpp"
+#include "broadphase.hpp"
 #include "components.hpp"
+#include "contacts.hpp"
+#include "events.hpp"
+#include "narrowphase.hpp"
+#include "parallel_collision.hpp"
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <cmath>
+#include <memory>
+#include <sstream>
+#include <utility>
 #include <vector>
 
 namespace game {
@@ -13,78 +25,93 @@ namespace example {
 
 /**
  * @brief System that handles movement by applying velocity to position.
- * Operates on entities with Position and Velocity components.
+ * Operates on entities with Position and Velocity components; its
+ * signature and access follow from the Reads/Writes lists, and
+ * StaticSystem reports the Position writes to observers.
  */
-class MovementSystem : public ecs::System {
-    ecs::World* world_;
-
+class MovementSystem : public ecs::StaticSystem<MovementSystem, ecs::Reads<Velocity>, ecs::Writes<Position>> {
 public:
-    explicit MovementSystem(ecs::World* world) : world_(world) {}
-
-    void tick(const float delta) override {
-        for (const auto entity : entities_) {
-            auto& position = world_->get_component<Position>(entity);
-            const auto& velocity = world_->get_component<Velocity>(entity);
-            
-            // Apply velocity to position
-            position.x += velocity.dx * delta;
-            position.y += velocity.dy * delta;
-        }
+    void update(const float delta, ecs::Entity, Position& position, const Velocity& velocity) noexcept {
+        // Apply velocity to position
+        position.x += velocity.dx * delta;
+        position.y += velocity.dy * delta;
     }
 };
 
 /**
  * @brief System for rendering entities with sprites.
- * Operates on entities with Position and Sprite components.
+ * Reads Position and Sprite from the frame snapshot, so with frame
+ * pipelining it runs alongside the next simulation tick.
  */
-class RenderSystem : public ecs::System {
-    ecs::World* world_;
+class RenderSystem : public ecs::LateSystem {
+    float time_accumulator_{0.0f};
 
 public:
-    explicit RenderSystem(ecs::World* world) : world_(world) {}
-
-    void tick(const float delta) override {
-        for (const auto entity : entities_) {
-            const auto& position = world_->get_component<Position>(entity);
-            const auto& sprite = world_->get_component<Sprite>(entity);
-            
-            // In a real game, this would render to the screen
-            // For demo purposes, we'll just print entity info occasionally
-            static float time_accumulator = 0.0f;
-            time_accumulator += delta;
-            
-            if (time_accumulator >= 2.0f) {  // Print every 2 seconds
-                std::cout << "Rendering " << sprite.texture_name 
-                         << " at (" << position.x << ", " << position.y << ")\n";
-                time_accumulator = 0.0f;
-            }
+    void tick(const ecs::FrameSnapshot& frame) override {
+        // In a real game, this would render to the screen
+        // For demo purposes, we'll just print entity info occasionally
+        time_accumulator_ += frame.get_delta();
+        if (time_accumulator_ < 2.0f) {  // Print every 2 seconds
+            return;
         }
+        time_accumulator_ = 0.0f;
+
+        // One write per line, since this may run beside the main thread's output
+        frame.view<Sprite, Position>().each([](ecs::Entity, const Sprite& sprite, const Position& position) {
+            std::ostringstream line;
+            line << "Rendering " << sprite.texture_name << " at (" << position.x << ", " << position.y << ")\n";
+            std::cout << line.str();
+        });
     }
 };
 
+/**
+ * @brief Movement input of one tick, as read from a device or a replay.
+ */
+struct PlayerInput {
+    float move_x{0.0f};
+    float move_y{0.0f};
+};
+
+/**
+ * @brief Stand-in for a real input device: steers along a figure-8.
+ * @param time Seconds since the session started
+ */
+[[nodiscard]] inline PlayerInput figure_eight_input(const float time) noexcept {
+    return PlayerInput{std::sin(time), std::sin(time * 2) * 0.5f};
+}
+
 /**
  * @brief System that handles player input and controls entities.
  * Operates on entities with Position, Velocity, and PlayerControlled components.
+ *
+ * The input is set from outside before each tick, so a replay can feed
+ * back exactly what a recorded session consumed.
  */
 class PlayerInputSystem : public ecs::System {
     ecs::World* world_;
+    PlayerInput input_{};
 
 public:
     explicit PlayerInputSystem(ecs::World* world) : world_(world) {}
 
+    void set_input(const PlayerInput& input) noexcept {
+        input_ = input;
+    }
+
+    [[nodiscard]] const PlayerInput& get_input() const noexcept {
+        return input_;
+    }
+
     void tick(const float delta) override {
-        for (const auto entity : entities_) {
+        for_each_enabled([&](const ecs::Entity entity) {
             auto& velocity = world_->get_component<Velocity>(entity);
-            const auto& player_ctrl = world_->get_component<PlayerControlled>(entity);
-            
-            // Simple input simulation - in a real game you'd read actual input
-            // For demo: make player entities move in a figure-8 pattern
-            static float time = 0.0f;
-            time += delta;
-            
-            velocity.dx = std::sin(time) * player_ctrl.move_speed;
-            velocity.dy = std::sin(time * 2) * player_ctrl.move_speed * 0.5f;
-        }
+            const auto& player_ctrl = std::as_const(*world_).get_component<PlayerControlled>(entity);
+
+            velocity.dx = input_.move_x * player_ctrl.move_speed;
+            velocity.dy = input_.move_y * player_ctrl.move_speed;
+            world_->mark_component_changed<Velocity>(entity);
+        });
     }
 };
 
@@ -94,15 +121,19 @@ public:
  */
 class AISystem : public ecs::System {
     ecs::World* world_;
+    // Per world rather than static, so a replayed world patrols like the recorded one
+    float patrol_time_{0.0f};
 
 public:
     explicit AISystem(ecs::World* world) : world_(world) {}
 
     void tick(const float delta) override {
-        for (const auto entity : entities_) {
-            const auto& position = world_->get_component<Position>(entity);
+        // Position and AI settings are only read, so they go through the const World
+        const auto& world = std::as_const(*world_);
+        for_each_enabled([&](const ecs::Entity entity) {
+            const auto& position = world.get_component<Position>(entity);
             auto& velocity = world_->get_component<Velocity>(entity);
-            const auto& ai = world_->get_component<AIControlled>(entity);
+            const auto& ai = world.get_component<AIControlled>(entity);
             
             // Simple AI: patrol around home position
             float dx = position.x - ai.home_position.x;
@@ -115,12 +146,12 @@ public:
                 velocity.dy = -dy / distance * 50.0f;
             } else {
                 // Random patrol movement
-                static float ai_time = 0.0f;
-                ai_time += delta;
-                velocity.dx = std::cos(ai_time + entity) * 30.0f;  // Use entity ID for variation
-                velocity.dy = std::sin(ai_time * 0.7f + entity) * 30.0f;
+                patrol_time_ += delta;
+                velocity.dx = std::cos(patrol_time_ + entity) * 30.0f;  // Use entity ID for variation
+                velocity.dy = std::sin(patrol_time_ * 0.7f + entity) * 30.0f;
             }
-        }
+            world_->mark_component_changed<Velocity>(entity);
+        });
     }
 };
 
@@ -135,18 +166,16 @@ public:
     explicit HealthSystem(ecs::World* world) : world_(world) {}
 
     void tick(const float delta) override {
-        for (const auto entity : entities_) {
-            const auto& health = world_->get_component<Health>(entity);
+        // for_each_enabled walks bitsets, so removing the visited entity is safe
+        for_each_enabled([&](const ecs::Entity entity) {
+            const auto& health = std::as_const(*world_).get_component<Health>(entity);
             
             if (!health.is_alive()) {
                 std::cout << "Entity " << entity << " died and will be removed!\n";
                 // In a real game, you might trigger death effects, drop items, etc.
                 world_->remove_entity(entity);
-                // Note: entity is now invalid, but the loop is safe as long as
-                // we don't process more entities in this frame
-                break;
             }
-        }
+        });
     }
 };
 
@@ -161,91 +190,190 @@ public:
     explicit LifetimeSystem(ecs::World* world) : world_(world) {}
 
     void tick(const float delta) override {
-        for (const auto entity : entities_) {
+        for_each_enabled([&](const ecs::Entity entity) {
             auto& lifetime = world_->get_component<Lifetime>(entity);
             
             lifetime.remaining_time -= delta;
-            
+            world_->mark_component_changed<Lifetime>(entity);
+
             if (lifetime.is_expired()) {
                 std::cout << "Entity " << entity << " lifetime expired, removing...\n";
                 world_->remove_entity(entity);
-                break;  // Safe iteration break after removal
             }
-        }
+        });
     }
 };
 
 /**
  * @brief System that handles collision detection between entities.
  * Operates on entities with Position and Collider components.
+ *
+ * A broadphase (uniform grid by default, or a dynamic AABB tree, chosen
+ * per world, for small colliders crowding around large ones) produces candidate pairs which a batched SoA narrow phase then tests
+ * circle against circle. BroadphaseKind::ParallelGrid instead runs both
+ * phases as a multi-threaded pipeline on the given JobSystem; its
+ * contact list is the same for any thread count. Contacts persist across
+ * frames, so the system emits Enter/Stay/Exit transitions instead of
+ * re-reporting every overlapping frame. Events say whether either
+ * collider is a trigger; the system itself applies no response.
  */
 class CollisionSystem : public ecs::System {
     ecs::World* world_;
+    std::unique_ptr<Broadphase> broadphase_;
+    std::unique_ptr<ParallelCollisionPipeline> pipeline_;
+    std::vector<ecs::Entity> colliders_;
+    std::vector<CollisionPair> pairs_;
+    CircleNarrowphase narrowphase_;
+    std::vector<CollisionPair> contacts_;
+    ContactTracker tracker_;
+    std::vector<ContactTracker::Transition> transitions_;
+
+public:
+    /**
+     * @param jobs Job system for BroadphaseKind::ParallelGrid, which requires one; it must outlive the system
+     */
+    explicit CollisionSystem(ecs::World* world, BroadphaseKind broadphase = BroadphaseKind::UniformGrid,
+                             ecs::JobSystem* jobs = nullptr)
+        : world_(world) {
+        if (broadphase == BroadphaseKind::ParallelGrid) {
+            assert(jobs && "ParallelGrid needs a JobSystem");
+            pipeline_ = std::make_unique<ParallelCollisionPipeline>(*jobs);
+        } else {
+            broadphase_ = make_broadphase(broadphase);
+        }
+    }
+
+    void tick(const float delta) override {
+        // Disabled colliders drop out of the broadphase and end their contacts
+        colliders_.clear();
+        for_each_enabled([&](const ecs::Entity entity) { colliders_.push_back(entity); });
+
+        contacts_.clear();
+        if (pipeline_) {
+            pipeline_->gather(*world_, colliders_);
+            pipeline_->find_contacts(contacts_);
+        } else {
+            pairs_.clear();
+            broadphase_->update(*world_, colliders_);
+            broadphase_->collect_pairs(pairs_);
+
+            // Broadphases report pairs in structure order; sort so responses are deterministic
+            std::sort(pairs_.begin(), pairs_.end());
+
+            narrowphase_.gather(*world_, colliders_);
+            narrowphase_.find_contacts(pairs_, contacts_);
+        }
+
+        transitions_.clear();
+        tracker_.update(contacts_, transitions_);
+
+        for (const auto& [pair, phase] : transitions_) {
+            const bool is_trigger = isTrigger(pair.first) || isTrigger(pair.second);
+
+            if (phase == ContactPhase::Enter) {
+                std::cout << "Collision detected between entity " << pair.first
+                         << " and entity " << pair.second << "!\n";
+            }
+
+            world_->events<CollisionEvent>().emit({pair.first, pair.second, phase, is_trigger});
+        }
+    }
+
+    /**
+     * @brief Ends the contacts of colliders that were destroyed or lost Position or Collider.
+     */
+    void entity_removed(const ecs::Entity entity) override {
+        tracker_.forget(entity);
+    }
+
+    [[nodiscard]] const ContactTracker& get_contacts() const noexcept {
+        return tracker_;
+    }
+
+private:
+    static std::unique_ptr<Broadphase> make_broadphase(const BroadphaseKind kind) {
+        if (kind == BroadphaseKind::UniformGrid) {
+            return std::make_unique<UniformGridBroadphase>();
+        }
+        return std::make_unique<AabbTreeBroadphase>();
+    }
+
+    [[nodiscard]] bool isTrigger(ecs::Entity entity) const {
+        // Exits may refer to entities destroyed since the last frame
+        return world_->has_component<Collider>(entity) && std::as_const(*world_).get_component<Collider>(entity).is_trigger;
+    }
+};
+
+/**
+ * @brief System that applies damage from collision events.
+ * Consumes CollisionEvent enter transitions in bulk; either side of a pair may be the attacker.
+ */
+class DamageSystem : public ecs::System {
+    ecs::World* world_;
 
 public:
-    explicit CollisionSystem(ecs::World* world) : world_(world) {}
+    explicit DamageSystem(ecs::World* world) : world_(world) {}
 
     void tick(const float delta) override {
-        // Simple O(n²) collision detection - in a real game you'd use spatial partitioning
-        std::vector<ecs::Entity> colliding_entities(entities_.begin(), entities_.end());
-        
-        for (size_t i = 0; i < colliding_entities.size(); ++i) {
-            for (size_t j = i + 1; j < colliding_entities.size(); ++j) {
-                auto entity1 = colliding_entities[i];
-                auto entity2 = colliding_entities[j];
-                
-                const auto& pos1 = world_->get_component<Position>(entity1);
-                const auto& pos2 = world_->get_component<Position>(entity2);
-                const auto& col1 = world_->get_component<Collider>(entity1);
-                const auto& col2 = world_->get_component<Collider>(entity2);
-                
-                // Check collision (circle-circle)
-                float dx = pos1.x - pos2.x;
-                float dy = pos1.y - pos2.y;
-                float distance = std::sqrt(dx * dx + dy * dy);
-                float min_distance = col1.radius + col2.radius;
-                
-                if (distance < min_distance) {
-                    // Collision detected!
-                    handleCollision(entity1, entity2);
-                }
+        for (const auto& event : world_->events<CollisionEvent>().read()) {
+            // Damage is dealt once per contact, not for every frame of overlap
+            if (event.phase != ContactPhase::Enter) {
+                continue;
             }
+            applyDamage(event.first, event.second);
+            applyDamage(event.second, event.first);
         }
     }
 
 private:
-    void handleCollision(ecs::Entity entity1, ecs::Entity entity2) {
-        // Simple collision response - in a real game this would be more sophisticated
-        static float last_collision_time = 0.0f;
-        static float current_time = 0.0f;
-        current_time += 0.016f;  // Assume ~60 FPS for demo
-        
-        if (current_time - last_collision_time > 1.0f) {  // Avoid spam
-            std::cout << "Collision detected between entity " << entity1 
-                     << " and entity " << entity2 << "!\n";
-            last_collision_time = current_time;
+    void applyDamage(ecs::Entity attacker, ecs::Entity target) {
+        // Either entity may already have been removed by an earlier event this frame
+        if (!world_->has_component<Damage>(attacker) || !world_->has_component<Health>(target)) {
+            return;
         }
-        
-        // Example: Handle damage if one entity has Damage component
-        if (world_->has_component<Damage>(entity1) && world_->has_component<Health>(entity2)) {
-            const auto& damage = world_->get_component<Damage>(entity1);
-            auto& health = world_->get_component<Health>(entity2);
-            
-            health.current -= damage.amount;
-            std::cout << "Entity " << entity2 << " took " << damage.amount 
-                     << " damage, health: " << health.current << "/" << health.maximum << "\n";
-                     
-            if (damage.destroy_on_hit) {
-                world_->remove_entity(entity1);
+
+        const auto& damage = std::as_const(*world_).get_component<Damage>(attacker);
+        auto& health = world_->get_component<Health>(target);
+
+        health.current -= damage.amount;
+        world_->mark_component_changed<Health>(target);
+        std::cout << "Entity " << target << " took " << damage.amount 
+                 << " damage, health: " << health.current << "/" << health.maximum << "\n";
+
+        if (damage.destroy_on_hit) {
+            world_->remove_entity(attacker);
+        }
+    }
+};
+
+/**
+ * @brief System that lets players pick up collectibles from collision events.
+ */
+class PickupSystem : public ecs::System {
+    ecs::World* world_;
+
+public:
+    explicit PickupSystem(ecs::World* world) : world_(world) {}
+
+    void tick(const float delta) override {
+        for (const auto& event : world_->events<CollisionEvent>().read()) {
+            if (event.phase != ContactPhase::Enter) {
+                continue;
             }
+            collect(event.first, event.second);
+            collect(event.second, event.first);
         }
-        
-        // Handle collectibles
-        if (world_->has_component<Collectible>(entity1) && world_->has_component<PlayerControlled>(entity2)) {
-            const auto& collectible = world_->get_component<Collectible>(entity1);
-            std::cout << "Player collected item worth " << collectible.score_value << " points!\n";
-            world_->remove_entity(entity1);
+    }
+
+private:
+    void collect(ecs::Entity item, ecs::Entity collector) {
+        if (!world_->has_component<Collectible>(item) || !world_->has_component<PlayerControlled>(collector)) {
+            return;
         }
+
+        const auto& collectible = std::as_const(*world_).get_component<Collectible>(item);
+        std::cout << "Player collected item worth " << collectible.score_value << " points!\n";
+        world_->remove_entity(item);
     }
 };
 
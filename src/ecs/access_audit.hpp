@@ -0,0 +1,189 @@
+#ifndef GAME_ECS_ACCESS_AUDIT_HPP
+#define GAME_ECS_ACCESS_AUDIT_HPP
+
+#include "ecs/entity.hpp"
+#include "ecs/entity_manager.hpp"
+#include <cstddef>
+
+#ifdef ECS_ACCESS_AUDIT
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#endif
+
+namespace game::ecs {
+
+/**
+ * @brief Component types a system only reads.
+ */
+template<typename... Ts>
+struct Reads {};
+
+/**
+ * @brief Component types a system reads and writes.
+ */
+template<typename... Ts>
+struct Writes {};
+
+/**
+ * @brief Component access a system declared with World::set_system_access().
+ */
+struct SystemAccess {
+    Signature reads{};
+    Signature writes{};
+    const char* name{""};
+
+    /**
+     * @brief Whether two systems may not run in the same stage.
+     */
+    [[nodiscard]] bool conflicts_with(const SystemAccess& other) const noexcept {
+        return (writes & (other.reads | other.writes)).any() || (other.writes & (reads | writes)).any();
+    }
+};
+
+#ifdef ECS_ACCESS_AUDIT
+
+namespace detail {
+
+/**
+ * @brief Systems that touched one pool during the current stage.
+ */
+struct PoolClaim {
+    std::atomic<const SystemAccess*> writer{nullptr};
+    std::atomic<const SystemAccess*> reader{nullptr};
+    std::atomic<bool> shared{false};
+};
+
+}
+
+/**
+ * @brief Debug checker for component access of systems (ECS_ACCESS_AUDIT builds only).
+ *
+ * The scheduler opens a stage around every group of systems that may
+ * run concurrently and a SystemScope around each system's tick on the
+ * thread running it. While a scope is open, every component access
+ * made through ComponentManager is checked against the system's
+ * declaration, and per-pool reader/writer ownership is recorded for the
+ * stage. The process is stopped with a diagnostic when:
+ *  - a system writes a component it did not declare in Writes<>;
+ *  - a system reads a component it declared in neither Reads<> nor Writes<>;
+ *  - two systems of one stage declare conflicting access;
+ *  - a pool is written by one system of a stage and touched by another.
+ *
+ * Accesses outside any scope (setup code, the main loop) are not checked.
+ */
+class AccessAudit {
+    static inline std::array<detail::PoolClaim, MAX_COMPONENT_TYPES> claims_{};
+    static inline thread_local const SystemAccess* current_{nullptr};
+
+public:
+    /**
+     * @brief Marks the running thread as executing a system until destroyed.
+     */
+    class SystemScope {
+        const SystemAccess* previous_;
+
+    public:
+        explicit SystemScope(const SystemAccess& access) noexcept : previous_(current_) {
+            current_ = &access;
+        }
+
+        SystemScope(const SystemScope&) = delete;
+        SystemScope& operator=(const SystemScope&) = delete;
+
+        ~SystemScope() {
+            current_ = previous_;
+        }
+    };
+
+    /**
+     * @brief Starts a stage of systems that may run concurrently.
+     */
+    static void begin_stage(const std::span<const SystemAccess* const> systems) noexcept {
+        for (std::size_t i = 0; i < systems.size(); ++i) {
+            for (std::size_t j = i + 1; j < systems.size(); ++j) {
+                if (systems[i]->conflicts_with(*systems[j])) {
+                    trap("systems %s and %s declare conflicting access but share a stage",
+                         systems[i]->name, systems[j]->name);
+                }
+            }
+        }
+        reset_claims();
+    }
+
+    static void end_stage() noexcept {
+        reset_claims();
+    }
+
+    /**
+     * @brief Checks one access to a component pool by the running system.
+     */
+    static void access(const std::size_t type, const bool write) noexcept {
+        const auto* system = current_;
+        if (system == nullptr) {
+            return;
+        }
+
+        if (write && !system->writes.test(type)) {
+            trap("system %s wrote component type %zu without declaring it in Writes<>", system->name, type);
+        }
+        if (!write && !(system->reads | system->writes).test(type)) {
+            trap("system %s read undeclared component type %zu", system->name, type);
+        }
+
+        auto& claim = claims_[type];
+        if (write) {
+            const SystemAccess* expected = nullptr;
+            if (!claim.writer.compare_exchange_strong(expected, system) && expected != system) {
+                trap("systems %s and %s both wrote component type %zu in one stage", expected->name, system->name, type);
+            }
+            const auto* reader = claim.reader.load();
+            if (reader != nullptr && (reader != system || claim.shared.load())) {
+                trap("system %s wrote component type %zu while another system of the stage read it", system->name, type);
+            }
+        } else {
+            const auto* writer = claim.writer.load();
+            if (writer != nullptr && writer != system) {
+                trap("system %s read component type %zu while system %s of the stage wrote it", system->name, type, writer->name);
+            }
+            const SystemAccess* expected = nullptr;
+            if (!claim.reader.compare_exchange_strong(expected, system) && expected != system) {
+                claim.shared.store(true);
+            }
+        }
+    }
+
+private:
+    static void reset_claims() noexcept {
+        for (auto& claim : claims_) {
+            claim.writer.store(nullptr);
+            claim.reader.store(nullptr);
+            claim.shared.store(false);
+        }
+    }
+
+    template<typename... Args>
+    [[noreturn]] static void trap(const char* format, Args... args) noexcept {
+        std::fprintf(stderr, "ECS access audit: ");
+        std::fprintf(stderr, format, args...);
+        std::fprintf(stderr, "\n");
+        std::abort();
+    }
+};
+
+#define ECS_AUDIT_READ(type) ::game::ecs::AccessAudit::access((type), false)
+#define ECS_AUDIT_WRITE(type) ::game::ecs::AccessAudit::access((type), true)
+
+#else
+
+// Arguments are not evaluated, so release builds do not even look up the type
+#define ECS_AUDIT_READ(type) ((void)0)
+#define ECS_AUDIT_WRITE(type) ((void)0)
+
+#endif
+
+}
+
+#endif//GAME_ECS_ACCESS_AUDIT_HPP
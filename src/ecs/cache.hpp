@@ -0,0 +1,128 @@
+#ifndef GAME_ECS_CACHE_HPP
+#define GAME_ECS_CACHE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <numeric>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Cache line size assumed for alignment and padding.
+ *
+ * std::hardware_destructive_interference_size is not reliably available
+ * and may differ between translation units, so the value is fixed.
+ */
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Wraps a value so it owns whole cache lines.
+ *
+ * Use for data written by one thread next to data written by another,
+ * such as per-worker counters or atomics updated from parallel systems,
+ * so the writes do not keep stealing the line from each other.
+ */
+template<typename T>
+struct alignas(CACHE_LINE_SIZE) CachePadded {
+    T value{};
+
+    T& operator*() noexcept {
+        return value;
+    }
+
+    const T& operator*() const noexcept {
+        return value;
+    }
+
+    T* operator->() noexcept {
+        return &value;
+    }
+
+    const T* operator->() const noexcept {
+        return &value;
+    }
+};
+
+/**
+ * @brief Allocator handing out cache-line-aligned storage.
+ */
+template<typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+
+    static constexpr std::size_t ALIGNMENT = alignof(T) > CACHE_LINE_SIZE ? alignof(T) : CACHE_LINE_SIZE;
+
+    CacheAlignedAllocator() noexcept = default;
+
+    template<typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) noexcept {}
+
+    T* allocate(const std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+
+    void deallocate(T* pointer, std::size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t{ALIGNMENT});
+    }
+
+    template<typename U>
+    bool operator==(const CacheAlignedAllocator<U>&) const noexcept {
+        return true;
+    }
+};
+
+/**
+ * @brief Vector whose data starts on a cache line boundary.
+ */
+template<typename T>
+using CacheAlignedVector = std::vector<T, CacheAlignedAllocator<T>>;
+
+/**
+ * @brief Rounds an element count up so chunks of it span whole cache lines.
+ *
+ * With storage that starts on a line boundary, chunks of this many
+ * elements never share a line with their neighbours, so parallel
+ * writers of adjacent chunks do not false-share. The count is a
+ * multiple of lcm(sizeof(T), CACHE_LINE_SIZE) / sizeof(T), the fewest
+ * elements that end exactly on a line, e.g. 16 for a 12-byte T.
+ *
+ * @tparam T Element type of the array being split
+ * @param grain Desired elements per chunk
+ */
+template<typename T>
+[[nodiscard]] constexpr std::size_t cache_aligned_grain(const std::size_t grain) noexcept {
+    constexpr std::size_t per_boundary = std::lcm(sizeof(T), CACHE_LINE_SIZE) / sizeof(T);
+    return (std::max<std::size_t>(grain, 1) + per_boundary - 1) / per_boundary * per_boundary;
+}
+
+/**
+ * @brief Half-open element range of one chunk.
+ */
+struct ChunkRange {
+    std::size_t begin{0};
+    std::size_t end{0};
+};
+
+/**
+ * @brief Splits [0, count) into parts chunks whose boundaries fall on cache lines.
+ *
+ * Chunks are as even as the rounding allows; trailing chunks may be
+ * empty when count is small. Splitting into zero parts yields an empty
+ * range for any part.
+ *
+ * @tparam T Element type of the array being split
+ */
+template<typename T>
+[[nodiscard]] constexpr ChunkRange cache_aligned_chunk(const std::size_t count, const std::size_t parts, const std::size_t part) noexcept {
+    if (parts == 0) {
+        return {};
+    }
+    const auto chunk = cache_aligned_grain<T>((count + parts - 1) / parts);
+    return {std::min(count, part * chunk), std::min(count, (part + 1) * chunk)};
+}
+
+}
+
+#endif//GAME_ECS_CACHE_HPP
@@ -0,0 +1,328 @@
+#ifndef GAME_ECS_COLD_STORAGE_ARRAY_HPP
+#define GAME_ECS_COLD_STORAGE_ARRAY_HPP
+
+#include "ecs/component_array.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_bitset.hpp"
+#include "ecs/lz_codec.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Component pool that compresses pages nobody touched for a while.
+ *
+ * The dense array is split into 4 KiB pages allocated on demand. Every
+ * access stamps its page with the pool's tick; compress_idle(), called
+ * by World::tick(), compresses pages whose stamp is idle_ticks old with
+ * the lz codec and frees them. The next access to a cold page
+ * decompresses it in place, so callers never see the difference except
+ * for that first-access latency. Pages that do not shrink stay hot.
+ * Whole-pool readers such as checkpoints use for_each_page(), which
+ * neither thaws nor stamps.
+ *
+ * For long-lived, rarely touched data of trivially copyable types. Reads
+ * may decompress and so modify the pool: unlike other pools it must not
+ * be read from several threads at once. There is no contiguous storage,
+ * so iterate it with World::view() instead of begin() / data().
+ */
+template<typename T>
+class ColdStorageArray final : public IComponentArray {
+    static_assert(std::is_trivially_copyable_v<T>, "Cold storage needs trivially copyable components");
+
+public:
+    /**
+     * @brief Components per page (4 KiB of components).
+     */
+    static constexpr std::size_t PAGE_SIZE = std::max<std::size_t>(1, 4096 / sizeof(T));
+
+    /**
+     * @brief Ticks a page stays uncompressed after its last access, by default.
+     */
+    static constexpr std::uint64_t DEFAULT_IDLE_TICKS = 600;
+
+private:
+    static constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t PAGE_COUNT = (MAX_ENTITIES + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    struct Page {
+        std::unique_ptr<T[]> hot;
+        std::vector<std::byte> cold;
+        std::uint64_t stamp{0};
+    };
+
+    // Thawed on const access too
+    mutable std::array<Page, PAGE_COUNT> pages_{};
+    mutable std::uint64_t thaw_count_{0};
+    std::array<std::size_t, MAX_ENTITIES> entity_to_index_;
+    std::array<Entity, MAX_ENTITIES> index_to_entity_{};
+    std::size_t size_{0};
+    EntityMask occupancy_{};
+    std::uint64_t tick_{0};
+    std::uint64_t idle_ticks_{DEFAULT_IDLE_TICKS};
+
+public:
+    ColdStorageArray() noexcept {
+        entity_to_index_.fill(NO_INDEX);
+    }
+
+    void insert(const Entity entity, T component) noexcept {
+        assert(entity < MAX_ENTITIES && "Entity ID out of range");
+        assert(!has(entity) && "Component already exists for entity");
+        assert(size_ < MAX_ENTITIES && "Component array is full");
+
+        const std::size_t new_index = size_++;
+        entity_to_index_[entity] = new_index;
+        index_to_entity_[new_index] = entity;
+        occupancy_.set(entity);
+        slot(new_index) = component;
+    }
+
+    void remove(const Entity entity) noexcept {
+        assert(has(entity) && "Component does not exist for entity");
+
+        const std::size_t removed = entity_to_index_[entity];
+        const std::size_t last = size_ - 1;
+        if (removed != last) {
+            slot(removed) = slot(last);
+            const Entity moved = index_to_entity_[last];
+            entity_to_index_[moved] = removed;
+            index_to_entity_[removed] = moved;
+        }
+
+        entity_to_index_[entity] = NO_INDEX;
+        occupancy_.reset(entity);
+        --size_;
+
+        // Give back a page once its last component is gone
+        if (size_ % PAGE_SIZE == 0) {
+            pages_[size_ / PAGE_SIZE] = {};
+        }
+    }
+
+    const T& get(const Entity entity) const noexcept {
+        return slot(index_of(entity));
+    }
+
+    T& get(const Entity entity) noexcept {
+        return slot(index_of(entity));
+    }
+
+    const T& at(const std::size_t index) const noexcept {
+        assert(index < size_ && "Component index out of range");
+        return slot(index);
+    }
+
+    T& at(const std::size_t index) noexcept {
+        assert(index < size_ && "Component index out of range");
+        return slot(index);
+    }
+
+    [[nodiscard]] bool has(const Entity entity) const noexcept {
+        return entity < MAX_ENTITIES && entity_to_index_[entity] != NO_INDEX;
+    }
+
+    [[nodiscard]] std::size_t index_of(const Entity entity) const noexcept {
+        assert(has(entity) && "Component does not exist for entity");
+        return entity_to_index_[entity];
+    }
+
+    [[nodiscard]] Entity entity_at(const std::size_t index) const noexcept {
+        assert(index < size_ && "Component index out of range");
+        return index_to_entity_[index];
+    }
+
+    [[nodiscard]] const EntityMask& occupancy() const noexcept {
+        return occupancy_;
+    }
+
+    /**
+     * @see ComponentArray::gather()
+     */
+    void gather(const std::span<const Entity> entities, const std::span<T> out) const noexcept {
+        assert(out.size() >= entities.size() && "Output span too small");
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            out[i] = get(entities[i]);
+        }
+    }
+
+    /**
+     * @see ComponentArray::scatter()
+     */
+    void scatter(const std::span<const Entity> entities, const std::span<const T> values) noexcept {
+        assert(values.size() >= entities.size() && "Value span too small");
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            get(entities[i]) = values[i];
+        }
+    }
+
+    /**
+     * @brief Prefetches the sparse index entry of an entity.
+     */
+    void prefetch_index(const Entity entity) const noexcept {
+        prefetch(&entity_to_index_[entity]);
+    }
+
+    /**
+     * @brief Prefetches the component of an entity if it has one in a hot page.
+     */
+    void prefetch_slot(const Entity entity) const noexcept {
+        if (has(entity)) {
+            const auto index = entity_to_index_[entity];
+            if (const auto& page = pages_[index / PAGE_SIZE]; page.hot) {
+                prefetch(&page.hot[index % PAGE_SIZE]);
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * @brief Calls f(first_index, components) for every page in index order, leaving the pool as it is.
+     *
+     * Cold pages are decompressed into a scratch page rather than thawed,
+     * and no page is stamped, so a full read does not keep pages hot.
+     */
+    template<typename F>
+    void for_each_page(F&& f) const {
+        std::unique_ptr<T[]> scratch;
+        for (std::size_t first = 0; first < size_; first += PAGE_SIZE) {
+            const auto& page = pages_[first / PAGE_SIZE];
+            const auto count = std::min(PAGE_SIZE, size_ - first);
+            if (page.hot) {
+                f(first, std::span<const T>(page.hot.get(), count));
+                continue;
+            }
+            if (!scratch) {
+                scratch = std::make_unique_for_overwrite<T[]>(PAGE_SIZE);
+            }
+            [[maybe_unused]] const auto written = lz::decompress(page.cold, std::as_writable_bytes(std::span(scratch.get(), PAGE_SIZE)));
+            assert(written != 0 && "Corrupt cold page");
+            f(first, std::span<const T>(scratch.get(), count));
+        }
+    }
+
+    /**
+     * @brief Sets how many ticks a page may go untouched before it is compressed.
+     */
+    void set_idle_ticks(const std::uint64_t ticks) noexcept {
+        idle_ticks_ = ticks;
+    }
+
+    [[nodiscard]] std::uint64_t get_idle_ticks() const noexcept {
+        return idle_ticks_;
+    }
+
+    /**
+     * @brief Advances the pool's tick and compresses pages untouched for more than idle_ticks.
+     *
+     * A page whose compressed form is not smaller than the page stays hot
+     * and is only tried again after another idle_ticks.
+     * @return Number of pages compressed
+     */
+    std::size_t compress_idle() {
+        ++tick_;
+        std::size_t compressed = 0;
+        for (std::size_t page = 0; page * PAGE_SIZE < size_; ++page) {
+            auto& [hot, cold, stamp] = pages_[page];
+            if (hot && tick_ - stamp > idle_ticks_) {
+                const auto count = std::min(PAGE_SIZE, size_ - page * PAGE_SIZE);
+                auto packed = lz::compress(std::as_bytes(std::span(hot.get(), count)));
+                if (packed.size() >= count * sizeof(T)) {
+                    stamp = tick_;
+                    continue;
+                }
+                cold = std::move(packed);
+                cold.shrink_to_fit();
+                hot.reset();
+                ++compressed;
+            }
+        }
+        return compressed;
+    }
+
+    [[nodiscard]] std::size_t hot_page_count() const noexcept {
+        return static_cast<std::size_t>(std::ranges::count_if(pages_, [](const Page& page) { return page.hot != nullptr; }));
+    }
+
+    [[nodiscard]] std::size_t cold_page_count() const noexcept {
+        return static_cast<std::size_t>(std::ranges::count_if(pages_, [](const Page& page) { return !page.hot && !page.cold.empty(); }));
+    }
+
+    /**
+     * @brief Heap bytes held by component pages, hot and compressed.
+     */
+    [[nodiscard]] std::size_t page_bytes() const noexcept {
+        std::size_t bytes = 0;
+        for (const auto& page : pages_) {
+            bytes += (page.hot ? PAGE_SIZE * sizeof(T) : 0) + page.cold.capacity();
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Number of pages decompressed since the pool was created.
+     */
+    [[nodiscard]] std::uint64_t get_thaw_count() const noexcept {
+        return thaw_count_;
+    }
+
+    void entity_destroyed(const Entity entity) override {
+        if (has(entity)) {
+            remove(entity);
+        }
+    }
+
+private:
+    T& slot(const std::size_t index) const noexcept {
+        auto& page = pages_[index / PAGE_SIZE];
+        if (!page.hot) {
+            thaw(page);
+        }
+        page.stamp = tick_;
+        return page.hot[index % PAGE_SIZE];
+    }
+
+    void thaw(Page& page) const noexcept {
+        page.hot = std::make_unique_for_overwrite<T[]>(PAGE_SIZE);
+        if (!page.cold.empty()) {
+            [[maybe_unused]] const auto written = lz::decompress(page.cold, std::as_writable_bytes(std::span(page.hot.get(), PAGE_SIZE)));
+            assert(written != 0 && "Corrupt cold page");
+            page.cold = {};
+            ++thaw_count_;
+        }
+    }
+};
+
+/**
+ * @brief Selects ColdStorageArray as the pool of T; see ECS_COLD_STORAGE.
+ */
+template<typename T>
+struct ColdStorage : std::false_type {};
+
+}
+
+/**
+ * @brief Stores a component type in a ColdStorageArray.
+ *
+ * Use at global scope right after the type's definition, so every
+ * translation unit sees the same pool type.
+ *
+ * Example: ECS_COLD_STORAGE(game::example::AIControlled)
+ */
+#define ECS_COLD_STORAGE(Type) \
+    template<>                 \
+    struct game::ecs::ColdStorage<Type> : std::true_type {};
+
+#endif//GAME_ECS_COLD_STORAGE_ARRAY_HPP
@@ -1,10 +1,15 @@
 #ifndef GAME_ECS_COMPONENT_ARRAY_HPP
 #define GAME_ECS_COMPONENT_ARRAY_HPP
 
+#include "cache.hpp"
 #include "entity.hpp"
+#include "entity_bitset.hpp"
+#include <algorithm>
 #include <array>
 #include <cassert>
-#include <unordered_map>
+#include <cstddef>
+#include <limits>
+#include <span>
 #include <utility>
 
 namespace game::ecs {
@@ -21,41 +26,67 @@ public:
     virtual void entity_destroyed(Entity entity) = 0;
 };
 
+/**
+ * @brief Hints the CPU to start loading a cache line that will be read soon.
+ */
+inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
 /**
  * @brief Dense component storage for a specific component type.
  * 
- * Uses dense array storage for cache efficiency. Maps entities
- * to array indices for O(1) component access while maintaining
+ * Uses dense array storage for cache efficiency. A sparse array maps
+ * entities to dense indices, so a lookup is a single load and batches
+ * of lookups can be prefetched, while the dense array keeps a
  * contiguous memory layout for optimal iteration performance.
  *
  * Includes iterator support.
  */
 template<typename T>
 class ComponentArray final : public IComponentArray {
-    std::array<T, MAX_ENTITIES> components_{};
-    std::unordered_map<Entity, std::size_t> entity_to_index_{};
-    std::unordered_map<std::size_t, Entity> index_to_entity_{};
+    static constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief How many entities ahead gather() and scatter() prefetch.
+     */
+    static constexpr std::size_t PREFETCH_DISTANCE = 8;
+
+    // Line-aligned so parallel chunks split with cache_aligned_chunk() never share a line
+    alignas(CACHE_LINE_SIZE) std::array<T, MAX_ENTITIES> components_{};
+    std::array<std::size_t, MAX_ENTITIES> entity_to_index_;
+    std::array<Entity, MAX_ENTITIES> index_to_entity_{};
     std::size_t size_{0};
+    EntityMask occupancy_{};
 
 public:
     // Type aliases for iterator support
     using iterator = typename std::array<T, MAX_ENTITIES>::iterator;
     using const_iterator = typename std::array<T, MAX_ENTITIES>::const_iterator;
 
+    ComponentArray() noexcept {
+        entity_to_index_.fill(NO_INDEX);
+    }
+
     void insert(const Entity entity, T component) noexcept {
-        assert(!entity_to_index_.contains(entity) && "Component already exists for entity");
-        assert(size_ < MAX_ENTITIES && "Component array is full");
         assert(entity < MAX_ENTITIES && "Entity ID out of range");
+        assert(!has(entity) && "Component already exists for entity");
+        assert(size_ < MAX_ENTITIES && "Component array is full");
 
         // Put new entry at end and update all mappings
         const std::size_t new_index = size_++;
         entity_to_index_[entity] = new_index;
+        occupancy_.set(entity);
         index_to_entity_[new_index] = entity;
         components_[new_index] = std::move(component);
     }
 
     void remove(const Entity entity) noexcept {
-        assert(entity_to_index_.contains(entity) && "Component does not exist for entity");
+        assert(has(entity) && "Component does not exist for entity");
         assert(size_ > 0 && "Cannot remove from empty component array");
 
         const std::size_t index_of_removed_entity = entity_to_index_[entity];
@@ -72,24 +103,132 @@ public:
             index_to_entity_[index_of_removed_entity] = entity_of_last_element;
         }
 
-        entity_to_index_.erase(entity);
-        index_to_entity_.erase(index_of_last_element);
+        entity_to_index_[entity] = NO_INDEX;
+        occupancy_.reset(entity);
 
         --size_;
     }
 
     const T& get(const Entity entity) const noexcept {
-        assert(entity_to_index_.contains(entity) && "Component does not exist for entity");
-        return components_[entity_to_index_.at(entity)];
+        assert(has(entity) && "Component does not exist for entity");
+        return components_[entity_to_index_[entity]];
     }
 
     T& get(const Entity entity) noexcept {
-        assert(entity_to_index_.find(entity) != entity_to_index_.end() && "Component does not exist for entity");
+        assert(has(entity) && "Component does not exist for entity");
         return components_[entity_to_index_[entity]];
     }
 
     [[nodiscard]] bool has(const Entity entity) const noexcept {
-        return entity_to_index_.contains(entity);
+        return entity < MAX_ENTITIES && entity_to_index_[entity] != NO_INDEX;
+    }
+
+    /**
+     * @brief Component at a dense index.
+     */
+    const T& at(const std::size_t index) const noexcept {
+        assert(index < size_ && "Component index out of range");
+        return components_[index];
+    }
+
+    T& at(const std::size_t index) noexcept {
+        assert(index < size_ && "Component index out of range");
+        return components_[index];
+    }
+
+    /**
+     * @brief Dense index of the component of an entity.
+     */
+    [[nodiscard]] std::size_t index_of(const Entity entity) const noexcept {
+        assert(has(entity) && "Component does not exist for entity");
+        return entity_to_index_[entity];
+    }
+
+    /**
+     * @brief Copies the components of a batch of entities.
+     *
+     * Resolves the dense slots of entities a few positions ahead and
+     * prefetches them, so the loads of a random access pattern overlap
+     * instead of stalling one after another.
+     *
+     * @param entities Entities that all have the component
+     * @param out Receives entities.size() components, in the same order
+     */
+    void gather(const std::span<const Entity> entities, const std::span<T> out) const noexcept {
+        assert(out.size() >= entities.size() && "Output is smaller than the entity list");
+
+        const std::size_t count = entities.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i + PREFETCH_DISTANCE < count) {
+                prefetch_slot(entities[i + PREFETCH_DISTANCE]);
+            }
+            out[i] = get(entities[i]);
+        }
+    }
+
+    /**
+     * @brief Writes back the components of a batch of entities.
+     * @param entities Entities that all have the component
+     * @param values New values, in the same order as entities
+     */
+    void scatter(const std::span<const Entity> entities, const std::span<const T> values) noexcept {
+        assert(values.size() >= entities.size() && "Fewer values than entities");
+
+        const std::size_t count = entities.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i + PREFETCH_DISTANCE < count) {
+                prefetch_slot(entities[i + PREFETCH_DISTANCE]);
+            }
+            get(entities[i]) = values[i];
+        }
+    }
+
+    /**
+     * @brief Bit per entity that has a component, for intersecting pools.
+     */
+    [[nodiscard]] const EntityMask& occupancy() const noexcept {
+        return occupancy_;
+    }
+
+    /**
+     * @brief Prefetches the sparse index entry of an entity.
+     *
+     * A later prefetch_slot() or has() of the entity then finds the
+     * entry in cache instead of stalling on it.
+     */
+    void prefetch_index(const Entity entity) const noexcept {
+        prefetch(&entity_to_index_[entity]);
+    }
+
+    /**
+     * @brief Prefetches the component of an entity, if it has one.
+     *
+     * Reads the entity's sparse index entry first, so the entry should
+     * already have been brought in with prefetch_index().
+     */
+    void prefetch_slot(const Entity entity) const noexcept {
+        if (has(entity)) {
+            prefetch(&components_[entity_to_index_[entity]]);
+        }
+    }
+
+    /**
+     * @brief Makes this array an exact copy of another, copying only live slots.
+     */
+    void copy_from(const ComponentArray& other) {
+        std::copy_n(other.components_.begin(), other.size_, components_.begin());
+        std::copy_n(other.index_to_entity_.begin(), other.size_, index_to_entity_.begin());
+        entity_to_index_ = other.entity_to_index_;
+        occupancy_ = other.occupancy_;
+        size_ = other.size_;
+    }
+
+    /**
+     * @brief Entity owning the component at a dense index.
+     */
+    [[nodiscard]] Entity entity_at(const std::size_t index) const noexcept {
+        assert(index < size_ && "Component index out of range");
+        return index_to_entity_[index];
     }
 
     // Iterator support for range-based for loops
@@ -131,7 +270,7 @@ public:
     }
 
     void entity_destroyed(const Entity entity) override {
-        if (entity_to_index_.contains(entity)) {
+        if (has(entity)) {
             remove(entity);
         }
     }
@@ -1,14 +1,21 @@
 #ifndef GAME_ECS_COMPONENT_MANAGER_HPP
 #define GAME_ECS_COMPONENT_MANAGER_HPP
 
+#include "ecs/access_audit.hpp"
 #include "ecs/component_array.hpp"
+#include "ecs/component_storage.hpp"
 #include "ecs/entity_manager.hpp"
 #include "ecs/entity.hpp"
+#include "ecs/runtime_component.hpp"
+#include <array>
 #include <cassert>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <string>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 namespace game::ecs {
 
@@ -20,16 +27,40 @@ namespace game::ecs {
  */
  using ComponentType = std::size_t;
 
+/**
+ * @brief Outcome of World::register_runtime_component().
+ */
+struct RuntimeRegistration {
+    std::optional<ComponentType> type{};
+    DescriptorError error{DescriptorError::None};
+
+    explicit operator bool() const noexcept {
+        return type.has_value();
+    }
+};
+
 /**
  * @brief Manages all component types and their storage.
  * 
  * Provides type-safe registration and access to component arrays.
  * Uses template metaprogramming to maintain type safety while
  * allowing runtime component management.
+ *
+ * In ECS_ACCESS_AUDIT builds every typed pool access is reported to
+ * AccessAudit: mutable access and add/remove count as writes, const
+ * access as reads. has_component() and entity_destroyed() only touch
+ * membership and are not audited.
  */
 class ComponentManager {
     std::unordered_map<std::type_index, ComponentType> component_types_{};
     std::unordered_map<std::type_index, std::unique_ptr<IComponentArray>> component_arrays_{};
+    std::unordered_map<std::string, ComponentType> runtime_types_{};
+    std::unordered_map<ComponentType, std::unique_ptr<RuntimeComponentArray>> runtime_arrays_{};
+    std::vector<IComponentArray*> double_buffered_arrays_{};
+    std::vector<std::size_t (*)(IComponentArray*)> publishers_{};
+    std::vector<IComponentArray*> cold_arrays_{};
+    std::vector<std::size_t (*)(IComponentArray*)> compressors_{};
+    std::array<const EntityMask*, MAX_COMPONENT_TYPES> occupancies_{};
     ComponentType next_sequenced_component_type_{0};
 
 public:
@@ -39,7 +70,106 @@ public:
         assert(!component_types_.contains(index) && "Component type already registered");
         assert(next_sequenced_component_type_ < MAX_COMPONENT_TYPES && "Too many component types registered");
         component_types_[index] = next_sequenced_component_type_++;
-        component_arrays_[index] = std::make_unique<ComponentArray<T>>();
+        auto storage = std::make_unique<ComponentStorage<T>>();
+        occupancies_[component_types_[index]] = &storage->occupancy();
+        component_arrays_[index] = std::move(storage);
+
+        if constexpr (DoubleBuffered<T>::value) {
+            double_buffered_arrays_.push_back(component_arrays_[index].get());
+            publishers_.push_back([](IComponentArray* array) {
+                return static_cast<DoubleBufferedArray<T>*>(array)->publish();
+            });
+        }
+        if constexpr (ColdStorage<T>::value) {
+            cold_arrays_.push_back(component_arrays_[index].get());
+            compressors_.push_back([](IComponentArray* array) {
+                return static_cast<ColdStorageArray<T>*>(array)->compress_idle();
+            });
+        }
+    }
+
+    /**
+     * @brief Advances cold pools by a tick, compressing their idle pages.
+     * @return Number of pages compressed
+     */
+    std::size_t compress_idle() {
+        std::size_t compressed = 0;
+        for (std::size_t i = 0; i < cold_arrays_.size(); ++i) {
+            compressed += compressors_[i](cold_arrays_[i]);
+        }
+        return compressed;
+    }
+
+    /**
+     * @brief Publishes the back buffers of all double-buffered pools.
+     * @return Number of pages copied
+     */
+    std::size_t publish_double_buffered() noexcept {
+        std::size_t copied = 0;
+        for (std::size_t i = 0; i < double_buffered_arrays_.size(); ++i) {
+            copied += publishers_[i](double_buffered_arrays_[i]);
+        }
+        return copied;
+    }
+
+    /**
+     * @brief Registers a component type described at runtime.
+     *
+     * The type takes the next sequential ID, so it shares signature bits
+     * with compile-time components. Descriptors usually come from data,
+     * so a bad one is refused with an error rather than asserted on.
+     *
+     * @return The component type ID, or why the descriptor was refused
+     */
+    RuntimeRegistration register_runtime_component(ComponentDescriptor descriptor) {
+        if (const auto error = validate_descriptor(descriptor); error != DescriptorError::None) {
+            return {std::nullopt, error};
+        }
+        if (runtime_types_.contains(descriptor.name)) {
+            return {std::nullopt, DescriptorError::DuplicateName};
+        }
+        if (next_sequenced_component_type_ >= MAX_COMPONENT_TYPES) {
+            return {std::nullopt, DescriptorError::TooManyTypes};
+        }
+
+        const auto type = next_sequenced_component_type_++;
+        runtime_types_[descriptor.name] = type;
+        runtime_arrays_[type] = std::make_unique<RuntimeComponentArray>(std::move(descriptor));
+        occupancies_[type] = &runtime_arrays_[type]->occupancy();
+        return {type, DescriptorError::None};
+    }
+
+    /**
+     * @brief Looks up a runtime component type by name.
+     * @return The type ID, or nullopt if no runtime type has that name
+     */
+    [[nodiscard]] std::optional<ComponentType> find_runtime_component_type(const std::string& name) const noexcept {
+        const auto it = runtime_types_.find(name);
+        return it != runtime_types_.end() ? std::optional<ComponentType>(it->second) : std::nullopt;
+    }
+
+    [[nodiscard]] bool is_runtime_component_registered(const std::string& name) const noexcept {
+        return runtime_types_.contains(name);
+    }
+
+    [[nodiscard]] RuntimeComponentArray* get_runtime_component_array(const ComponentType type) noexcept {
+        const auto it = runtime_arrays_.find(type);
+        assert(it != runtime_arrays_.end() && "Not a runtime component type");
+        return it->second.get();
+    }
+
+    [[nodiscard]] const RuntimeComponentArray* get_runtime_component_array(const ComponentType type) const noexcept {
+        const auto it = runtime_arrays_.find(type);
+        assert(it != runtime_arrays_.end() && "Not a runtime component type");
+        return it->second.get();
+    }
+
+    /**
+     * @brief Occupancy bitset of any registered pool, compile-time or runtime.
+     * @return The bitset, or nullptr if no pool has that type ID
+     */
+    [[nodiscard]] const EntityMask* get_occupancy(const ComponentType type) const noexcept {
+        return type < MAX_COMPONENT_TYPES ? occupancies_[type] : nullptr;
     }
 
     template<typename T>
@@ -50,48 +180,67 @@ public:
 
     template<typename T>
     void add_component(const Entity entity, T component) noexcept {
-        get_component_array<T>()->insert(entity, std::move(component));
+        ECS_AUDIT_WRITE(get_component_type<T>());
+        array<T>()->insert(entity, std::move(component));
     }
 
     template<typename T>
     void remove_component(const Entity entity) noexcept {
-        get_component_array<T>()->remove(entity);
+        ECS_AUDIT_WRITE(get_component_type<T>());
+        array<T>()->remove(entity);
     }
 
     template<typename T>
     [[nodiscard]] const T& get_component(const Entity entity) const noexcept {
-        return get_component_array<T>()->get(entity);
+        ECS_AUDIT_READ(get_component_type<T>());
+        return array<T>()->get(entity);
     }
 
     template<typename T>
     [[nodiscard]] T& get_component(const Entity entity) noexcept {
-        return get_component_array<T>()->get(entity);
+        ECS_AUDIT_WRITE(get_component_type<T>());
+        return array<T>()->get(entity);
     }
 
     template<typename T>
     [[nodiscard]] bool has_component(const Entity entity) const noexcept {
-        return get_component_array<T>()->has(entity);
+        return array<T>()->has(entity);
     }
 
     void entity_destroyed(const Entity entity) noexcept {
         for (const auto &array: component_arrays_ | std::views::values) {
             array->entity_destroyed(entity);
         }
+        for (const auto &array: runtime_arrays_ | std::views::values) {
+            array->entity_destroyed(entity);
+        }
+    }
+
+    template<typename T>
+    ComponentStorage<T>* get_component_array() noexcept {
+        ECS_AUDIT_WRITE(get_component_type<T>());
+        return array<T>();
+    }
+
+    template<typename T>
+    const ComponentStorage<T>* get_component_array() const noexcept {
+        ECS_AUDIT_READ(get_component_type<T>());
+        return array<T>();
     }
 
 private:
     template<typename T>
-    ComponentArray<T>* get_component_array() noexcept {
+    ComponentStorage<T>* array() noexcept {
         const auto index = std::type_index(typeid(T));
         assert(component_types_.contains(index) && "Component type not registered");
-        return static_cast<ComponentArray<T>*>(component_arrays_.at(index).get());
+        return static_cast<ComponentStorage<T>*>(component_arrays_.at(index).get());
     }
 
     template<typename T>
-    const ComponentArray<T>* get_component_array() const noexcept {
+    const ComponentStorage<T>* array() const noexcept {
         const auto index = std::type_index(typeid(T));
         assert(component_types_.contains(index) && "Component type not registered");
-        return static_cast<const ComponentArray<T>*>(component_arrays_.at(index).get());
+        return static_cast<const ComponentStorage<T>*>(component_arrays_.at(index).get());
     }
 };
 
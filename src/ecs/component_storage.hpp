@@ -0,0 +1,57 @@
+#ifndef GAME_ECS_COMPONENT_STORAGE_HPP
+#define GAME_ECS_COMPONENT_STORAGE_HPP
+
+#include "ecs/cold_storage_array.hpp"
+#include "ecs/component_array.hpp"
+#include "ecs/double_buffered_array.hpp"
+#include <type_traits>
+
+namespace game::ecs {
+
+/**
+ * @brief Pool type that stores components of type T.
+ */
+template<typename T>
+using ComponentStorage = std::conditional_t<DoubleBuffered<T>::value, DoubleBufferedArray<T>,
+                                            std::conditional_t<ColdStorage<T>::value, ColdStorageArray<T>, ComponentArray<T>>>;
+
+/**
+ * @brief Pool type the published values of T are read from.
+ *
+ * The front buffer for double-buffered types, the pool itself otherwise.
+ */
+template<typename T>
+using PublishedStorage = std::conditional_t<DoubleBuffered<T>::value, ComponentArray<T>, ComponentStorage<T>>;
+
+/**
+ * @brief Pool the published (front) values of T are read from.
+ */
+template<typename T>
+[[nodiscard]] const PublishedStorage<T>& published(const ComponentStorage<T>& pool) noexcept {
+    static_assert(!(DoubleBuffered<T>::value && ColdStorage<T>::value), "A component type cannot be both double-buffered and cold");
+    if constexpr (DoubleBuffered<T>::value) {
+        return pool.front();
+    } else {
+        return pool;
+    }
+}
+
+/**
+ * @brief Pool the latest values of T are read from, including writes not yet published.
+ *
+ * The back buffer for double-buffered types, the pool itself otherwise.
+ * Reading it never marks pages dirty. Meant for consumers that must see
+ * the current frame, such as checkpoints, digests and page eviction.
+ */
+template<typename T>
+[[nodiscard]] const PublishedStorage<T>& latest(const ComponentStorage<T>& pool) noexcept {
+    if constexpr (DoubleBuffered<T>::value) {
+        return pool.back();
+    } else {
+        return pool;
+    }
+}
+
+}
+
+#endif//GAME_ECS_COMPONENT_STORAGE_HPP
@@ -0,0 +1,272 @@
+#ifndef GAME_ECS_DOUBLE_BUFFERED_ARRAY_HPP
+#define GAME_ECS_DOUBLE_BUFFERED_ARRAY_HPP
+
+#include "ecs/cache.hpp"
+#include "ecs/component_array.hpp"
+#include "ecs/entity.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace game::ecs {
+
+/**
+ * @brief Component pool with a front buffer for readers and a back buffer for writers.
+ *
+ * Mutable access (get(), scatter(), at(), data()) goes to the back
+ * buffer and marks the touched pages dirty; const access reads the
+ * front buffer, which holds the values of the last publish(). Readers
+ * and writers of one frame can therefore run concurrently without
+ * locks or ordering: readers see the previous frame. publish(), called
+ * by World::tick() at the frame boundary, copies only the dirty pages
+ * from back to front.
+ *
+ * Inserts and removes change both buffers at once and must not run
+ * concurrently with readers, as for any pool.
+ */
+template<typename T>
+class DoubleBufferedArray final : public IComponentArray {
+public:
+    /**
+     * @brief Components per dirty-tracking page (4 KiB of components).
+     */
+    static constexpr std::size_t PAGE_SIZE = std::max<std::size_t>(1, 4096 / sizeof(T));
+
+private:
+    static constexpr std::size_t PAGE_COUNT = (MAX_ENTITIES + PAGE_SIZE - 1) / PAGE_SIZE;
+    static constexpr std::size_t DIRTY_WORDS = (PAGE_COUNT + 63) / 64;
+
+    ComponentArray<T> front_{};
+    ComponentArray<T> back_{};
+    // Set from any writer thread, cleared by publish()
+    std::array<std::atomic<std::uint64_t>, DIRTY_WORDS> dirty_{};
+
+public:
+    using iterator = typename ComponentArray<T>::iterator;
+    using const_iterator = typename ComponentArray<T>::const_iterator;
+
+    void insert(const Entity entity, T component) noexcept {
+        front_.insert(entity, component);
+        back_.insert(entity, std::move(component));
+    }
+
+    void remove(const Entity entity) noexcept {
+        assert(has(entity) && "Component does not exist for entity");
+        const auto index = back_.index_of(entity);
+        const auto last = back_.size() - 1;
+        front_.remove(entity);
+        back_.remove(entity);
+
+        // The back value moved into the hole may be newer than the front one
+        if (index != last) {
+            mark_dirty(index);
+        }
+    }
+
+    /**
+     * @brief Published value of a component.
+     */
+    const T& get(const Entity entity) const noexcept {
+        return front_.get(entity);
+    }
+
+    /**
+     * @brief Value being written this frame; marks its page dirty.
+     */
+    T& get(const Entity entity) noexcept {
+        const auto index = back_.index_of(entity);
+        mark_dirty(index);
+        return back_.data()[index];
+    }
+
+    const T& at(const std::size_t index) const noexcept {
+        return front_.at(index);
+    }
+
+    T& at(const std::size_t index) noexcept {
+        mark_dirty(index);
+        return back_.at(index);
+    }
+
+    [[nodiscard]] bool has(const Entity entity) const noexcept {
+        return back_.has(entity);
+    }
+
+    /**
+     * @brief Copies published components of a batch of entities.
+     * @see ComponentArray::gather()
+     */
+    void gather(const std::span<const Entity> entities, const std::span<T> out) const noexcept {
+        front_.gather(entities, out);
+    }
+
+    /**
+     * @brief Writes components of a batch of entities to the back buffer.
+     * @see ComponentArray::scatter()
+     */
+    void scatter(const std::span<const Entity> entities, const std::span<const T> values) noexcept {
+        for (const auto entity : entities) {
+            mark_dirty(back_.index_of(entity));
+        }
+        back_.scatter(entities, values);
+    }
+
+    void prefetch_index(const Entity entity) const noexcept {
+        back_.prefetch_index(entity);
+    }
+
+    /**
+     * @brief Prefetches the back buffer slot, which mutable views read and write.
+     */
+    void prefetch_slot(const Entity entity) const noexcept {
+        back_.prefetch_slot(entity);
+    }
+
+    [[nodiscard]] const EntityMask& occupancy() const noexcept {
+        return back_.occupancy();
+    }
+
+    [[nodiscard]] Entity entity_at(const std::size_t index) const noexcept {
+        return back_.entity_at(index);
+    }
+
+    [[nodiscard]] std::size_t index_of(const Entity entity) const noexcept {
+        return back_.index_of(entity);
+    }
+
+    const_iterator begin() const noexcept {
+        return front_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return front_.end();
+    }
+
+    /**
+     * @brief Back buffer for bulk writes; marks every page dirty.
+     */
+    iterator begin() noexcept {
+        mark_all_dirty();
+        return back_.begin();
+    }
+
+    iterator end() noexcept {
+        return back_.end();
+    }
+
+    const T* data() const noexcept {
+        return front_.data();
+    }
+
+    /**
+     * @brief Back buffer for bulk writes; marks every page dirty.
+     */
+    T* data() noexcept {
+        mark_all_dirty();
+        return back_.data();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return back_.size();
+    }
+
+    /**
+     * @brief Published buffer, e.g. for snapshots.
+     */
+    [[nodiscard]] const ComponentArray<T>& front() const noexcept {
+        return front_;
+    }
+
+    /**
+     * @brief Buffer being written this frame, read without marking pages dirty.
+     */
+    [[nodiscard]] const ComponentArray<T>& back() const noexcept {
+        return back_;
+    }
+
+    /**
+     * @brief Copies dirty pages from the back to the front buffer.
+     *
+     * Must not run concurrently with readers or writers of the pool.
+     *
+     * @return Number of pages copied
+     */
+    std::size_t publish() noexcept {
+        std::size_t copied = 0;
+        const auto size = back_.size();
+        for (std::size_t word = 0; word < DIRTY_WORDS; ++word) {
+            auto bits = dirty_[word].exchange(0, std::memory_order_acquire);
+            while (bits != 0) {
+                const auto page = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+
+                const auto begin = page * PAGE_SIZE;
+                if (begin < size) {
+                    const auto end = std::min(size, begin + PAGE_SIZE);
+                    std::copy(back_.data() + begin, back_.data() + end, front_.data() + begin);
+                    ++copied;
+                }
+            }
+        }
+        return copied;
+    }
+
+    [[nodiscard]] std::size_t dirty_page_count() const noexcept {
+        std::size_t count = 0;
+        for (const auto& word : dirty_) {
+            count += static_cast<std::size_t>(std::popcount(word.load(std::memory_order_relaxed)));
+        }
+        return count;
+    }
+
+    void entity_destroyed(const Entity entity) override {
+        if (has(entity)) {
+            remove(entity);
+        }
+    }
+
+private:
+    void mark_dirty(const std::size_t index) noexcept {
+        const auto page = index / PAGE_SIZE;
+        auto& word = dirty_[page / 64];
+        const auto bit = std::uint64_t{1} << (page % 64);
+        // Skip the read-modify-write, and the line transfer, when already set
+        if ((word.load(std::memory_order_relaxed) & bit) == 0) {
+            word.fetch_or(bit, std::memory_order_release);
+        }
+    }
+
+    void mark_all_dirty() noexcept {
+        for (std::size_t page = 0; page * PAGE_SIZE < back_.size(); ++page) {
+            mark_dirty(page * PAGE_SIZE);
+        }
+    }
+};
+
+/**
+ * @brief Selects DoubleBufferedArray as the pool of T; see ECS_DOUBLE_BUFFERED.
+ */
+template<typename T>
+struct DoubleBuffered : std::false_type {};
+
+}
+
+/**
+ * @brief Stores a component type in a DoubleBufferedArray.
+ *
+ * Use at global scope right after the type's definition, so every
+ * translation unit sees the same pool type.
+ *
+ * Example: ECS_DOUBLE_BUFFERED(game::example::Position)
+ */
+#define ECS_DOUBLE_BUFFERED(Type) \
+    template<>                    \
+    struct game::ecs::DoubleBuffered<Type> : std::true_type {};
+
+#endif//GAME_ECS_DOUBLE_BUFFERED_ARRAY_HPP
@@ -0,0 +1,171 @@
+#ifndef GAME_ECS_ENTITY_BITSET_HPP
+#define GAME_ECS_ENTITY_BITSET_HPP
+
+#include "ecs/entity.hpp"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace game::ecs {
+
+/**
+ * @brief Dense bit per entity ID, scanned a 64-bit word at a time.
+ *
+ * Two levels: a leaf word per 64 IDs and a summary word per 4096 IDs
+ * whose bits tell which of its 64 leaf words are non-zero. Setting,
+ * clearing and testing a bit is O(1). for_each() and
+ * for_each_intersection() walk the summary words first, so empty
+ * 4096-ID regions cost one load and empty 64-ID words none; every set
+ * bit is found with countr_zero. The visited leaf word is re-read
+ * after each callback, so callbacks may clear bits ahead of the walk.
+ *
+ * @tparam Size Number of entity IDs covered
+ */
+template<std::size_t Size>
+class EntityBitset {
+public:
+    static constexpr std::size_t WORD_COUNT = (Size + 63) / 64;
+    static constexpr std::size_t SUMMARY_COUNT = (WORD_COUNT + 63) / 64;
+
+private:
+    std::array<std::uint64_t, WORD_COUNT> words_{};
+    std::array<std::uint64_t, SUMMARY_COUNT> summary_{};
+
+public:
+    void set(const Entity entity) noexcept {
+        assert(entity < Size && "Entity out-of-range");
+        words_[entity / 64] |= bit(entity);
+        summary_[entity / 4096] |= bit(entity / 64);
+    }
+
+    void reset(const Entity entity) noexcept {
+        assert(entity < Size && "Entity out-of-range");
+        auto& word = words_[entity / 64];
+        word &= ~bit(entity);
+        if (word == 0) {
+            summary_[entity / 4096] &= ~bit(entity / 64);
+        }
+    }
+
+    void assign(const Entity entity, const bool value) noexcept {
+        value ? set(entity) : reset(entity);
+    }
+
+    [[nodiscard]] bool test(const Entity entity) const noexcept {
+        assert(entity < Size && "Entity out-of-range");
+        return (words_[entity / 64] & bit(entity)) != 0;
+    }
+
+    void clear() noexcept {
+        words_.fill(0);
+        summary_.fill(0);
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept {
+        std::size_t count = 0;
+        for (const auto word : words_) {
+            count += static_cast<std::size_t>(std::popcount(word));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Calls f(entity) for every set bit, in ascending order.
+     */
+    template<typename F>
+    void for_each(F&& f) const {
+        for_each_intersection(f);
+    }
+
+    /**
+     * @brief Calls f(entity) for every bit set here and in all others, in ascending order.
+     *
+     * Summary words are ANDed first, so a region empty in any of the
+     * sets is skipped without reading its leaf words. Leaf words are
+     * re-read after every call, so f may clear any bit, e.g. remove
+     * other entities, and cleared bits further on are not visited.
+     * Bits set during the walk may or may not be visited.
+     */
+    template<typename F, typename... Others>
+    void for_each_intersection(F&& f, const Others&... others) const {
+        static_assert((std::is_same_v<Others, EntityBitset> && ...), "Bitsets must cover the same IDs");
+
+        for (std::size_t region = 0; region < SUMMARY_COUNT; ++region) {
+            for (auto words = (summary_[region] & ... & others.summary_[region]); words != 0; words &= words - 1) {
+                const auto word = region * 64 + static_cast<std::size_t>(std::countr_zero(words));
+                for (auto bits = (words_[word] & ... & others.words_[word]); bits != 0;) {
+                    f(static_cast<Entity>(word * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+                    bits &= (bits - 1) & (words_[word] & ... & others.words_[word]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Calls f(entity) for every bit set in all of sets, in ascending order.
+     *
+     * for_each_intersection() for a number of sets only known at run
+     * time, e.g. one per bit of a Signature. Does nothing if sets is
+     * empty. Like for_each_intersection(), f may clear any bit.
+     */
+    template<typename F>
+    static void for_each_intersection_of(const std::span<const EntityBitset* const> sets, F&& f) {
+        if (sets.empty()) {
+            return;
+        }
+
+        for (std::size_t region = 0; region < SUMMARY_COUNT; ++region) {
+            auto words = ~std::uint64_t{0};
+            for (std::size_t i = 0; i < sets.size() && words != 0; ++i) {
+                words &= sets[i]->summary_[region];
+            }
+            for (; words != 0; words &= words - 1) {
+                const auto word = region * 64 + static_cast<std::size_t>(std::countr_zero(words));
+                for (auto bits = intersect_word(sets, word, ~std::uint64_t{0}); bits != 0;) {
+                    f(static_cast<Entity>(word * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+                    bits = intersect_word(sets, word, bits & (bits - 1));
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] const std::array<std::uint64_t, WORD_COUNT>& words() const noexcept {
+        return words_;
+    }
+
+    /**
+     * @brief Summary words; bit i of word r is set when leaf word r * 64 + i is non-zero.
+     */
+    [[nodiscard]] const std::array<std::uint64_t, SUMMARY_COUNT>& summary() const noexcept {
+        return summary_;
+    }
+
+private:
+    [[nodiscard]] static std::uint64_t bit(const Entity entity) noexcept {
+        return std::uint64_t{1} << (entity % 64);
+    }
+
+    /**
+     * @brief ANDs the current leaf word of every set into bits.
+     */
+    [[nodiscard]] static std::uint64_t intersect_word(const std::span<const EntityBitset* const> sets,
+                                                      const std::size_t word, std::uint64_t bits) noexcept {
+        for (std::size_t i = 0; i < sets.size() && bits != 0; ++i) {
+            bits &= sets[i]->words_[word];
+        }
+        return bits;
+    }
+};
+
+/**
+ * @brief Bit per entity ID of the world.
+ */
+using EntityMask = EntityBitset<MAX_ENTITIES>;
+
+}
+
+#endif//GAME_ECS_ENTITY_BITSET_HPP
@@ -1,12 +1,16 @@
 #ifndef GAME_ECS_ENTITY_MANAGER_HPP
 #define GAME_ECS_ENTITY_MANAGER_HPP
 
+#include "cache.hpp"
 #include "entity.hpp"
+#include "entity_bitset.hpp"
 #include <bitset>
 #include <cstdint>
 #include <queue>
 #include <array>
 #include <cassert>
+#include <span>
+#include <vector>
 
 namespace game::ecs {
 
@@ -28,7 +32,12 @@ using Signature = std::bitset<MAX_COMPONENT_TYPES>;
 class EntityManager {
     std::queue<Entity> available_entities_{};
     std::array<Signature, MAX_ENTITIES> signatures_{};
-    std::uint64_t living_entity_count_{0};
+    // IDs handed out and not yet removed
+    EntityMask living_{};
+    // Living entities that views and systems visit
+    EntityMask enabled_{};
+    // Kept off the signature table's last line, which systems read concurrently
+    alignas(CACHE_LINE_SIZE) std::uint64_t living_entity_count_{0};
 
 public:
     EntityManager() {
@@ -41,6 +50,8 @@ public:
         // Take an ID from the front of the queue
         const Entity new_id = available_entities_.front();
         available_entities_.pop();
+        living_.set(new_id);
+        enabled_.set(new_id);
         ++living_entity_count_;
 
         return new_id;
@@ -51,6 +62,8 @@ public:
 
         // Invalidate the destroyed entity's signature
         signatures_[entity].reset();
+        living_.reset(entity);
+        enabled_.reset(entity);
 
         // Put the destroyed ID at the back of the queue for reuse
         available_entities_.push(entity);
@@ -72,10 +85,74 @@ public:
         return signatures_[entity];
     }
 
+    /**
+     * @brief Enables or disables a living entity without touching its components.
+     */
+    void set_enabled(const Entity entity, const bool enabled) noexcept {
+        assert(entity < MAX_ENTITIES && "Entity out-of-range");
+        assert(living_.test(entity) && "Entity is not alive");
+        enabled_.assign(entity, enabled);
+    }
+
+    [[nodiscard]] bool is_alive(const Entity entity) const noexcept {
+        return entity < MAX_ENTITIES && living_.test(entity);
+    }
+
+    [[nodiscard]] bool is_enabled(const Entity entity) const noexcept {
+        assert(entity < MAX_ENTITIES && "Entity out-of-range");
+        return enabled_.test(entity);
+    }
+
+    /**
+     * @brief Bits of the living, enabled entities.
+     */
+    [[nodiscard]] const EntityMask& get_enabled_mask() const noexcept {
+        return enabled_;
+    }
+
     [[nodiscard]] std::uint64_t get_living_entity_count() const noexcept {
         return living_entity_count_;
     }
 
+    /**
+     * @brief Copies the recycling queue in the order IDs will be handed out.
+     */
+    [[nodiscard]] std::vector<Entity> get_available_entities() const {
+        auto queue = available_entities_;
+        std::vector<Entity> available;
+        available.reserve(queue.size());
+        while (!queue.empty()) {
+            available.push_back(queue.front());
+            queue.pop();
+        }
+        return available;
+    }
+
+    /**
+     * @brief Replaces the recycling queue, e.g. when restoring a saved world.
+     *
+     * Every ID missing from the queue is considered alive and enabled
+     * afterwards; callers holding a saved enabled mask disable the
+     * paused IDs themselves. Only valid on a manager with no living entities.
+     */
+    void restore_available_entities(const std::span<const Entity> available) noexcept {
+        assert(living_entity_count_ == 0 && "Cannot restore into a populated entity manager");
+        assert(available.size() <= MAX_ENTITIES && "Too many available entities");
+
+        available_entities_ = {};
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            living_.set(entity);
+            enabled_.set(entity);
+        }
+        for (const auto entity : available) {
+            assert(entity < MAX_ENTITIES && "Entity out-of-range");
+            available_entities_.push(entity);
+            living_.reset(entity);
+            enabled_.reset(entity);
+        }
+        living_entity_count_ = MAX_ENTITIES - available.size();
+    }
+
 private:
     void initialize_queue_with_all_possible_entities() noexcept {
         for (Entity entity = 0; entity < MAX_ENTITIES; entity++) {
@@ -0,0 +1,159 @@
+#ifndef GAME_ECS_EVENT_BUS_HPP
+#define GAME_ECS_EVENT_BUS_HPP
+
+#include "ecs/cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Interface for type-erased event queues.
+ *
+ * Lets the EventBus flip every queue at the frame boundary
+ * without knowing the concrete event types.
+ */
+class IEventQueue {
+public:
+    virtual ~IEventQueue() = default;
+    virtual void swap_buffers() = 0;
+};
+
+/**
+ * @brief Double-buffered, contiguous queue for a specific event type.
+ *
+ * Producers append to the back buffer through an atomic cursor, so
+ * systems running in parallel can emit without taking a lock. At the
+ * frame boundary the buffers are flipped and the events become readable
+ * as one contiguous span for the whole of the next frame.
+ *
+ * Writes that exceed the current back buffer capacity spill into a
+ * mutex-guarded overflow vector. The capacity then grows to the
+ * high-water mark so the next frame stays on the lock-free path.
+ */
+template<typename T>
+class EventQueue final : public IEventQueue {
+    static_assert(std::is_default_constructible_v<T>, "Events must be default constructible");
+    static_assert(std::is_move_assignable_v<T>, "Events must be move assignable");
+
+    std::vector<T> front_{};
+    std::size_t front_size_{0};
+    std::vector<T> back_{};
+    // Written by every producer; kept off the line holding back_'s size and data pointer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> back_cursor_{0};
+    std::vector<T> overflow_{};
+    std::mutex overflow_mutex_{};
+    std::size_t capacity_{0};
+
+public:
+    explicit EventQueue(const std::size_t initial_capacity = 1024)
+        : front_(initial_capacity), back_(initial_capacity), capacity_(initial_capacity) {}
+
+    /**
+     * @brief Queues an event for consumption next frame.
+     *
+     * Safe to call concurrently from any number of producers,
+     * but not concurrently with swap_buffers().
+     */
+    void emit(T event) {
+        const std::size_t slot = back_cursor_.fetch_add(1, std::memory_order_relaxed);
+        if (slot < back_.size()) {
+            back_[slot] = std::move(event);
+            return;
+        }
+
+        std::lock_guard lock(overflow_mutex_);
+        overflow_.push_back(std::move(event));
+    }
+
+    /**
+     * @brief Events emitted during the previous frame.
+     */
+    [[nodiscard]] std::span<const T> read() const noexcept {
+        return {front_.data(), front_size_};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return front_size_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return front_size_ == 0;
+    }
+
+    void swap_buffers() override {
+        const std::size_t written = std::min(back_cursor_.load(std::memory_order_acquire), back_.size());
+        std::swap(front_, back_);
+        front_size_ = written;
+
+        if (!overflow_.empty()) {
+            // Keep the readable span contiguous by appending spilled events
+            front_.resize(front_size_);
+            std::move(overflow_.begin(), overflow_.end(), std::back_inserter(front_));
+            front_size_ = front_.size();
+            overflow_.clear();
+        }
+
+        capacity_ = std::max(capacity_, front_size_);
+        if (back_.size() < capacity_) {
+            back_.resize(capacity_);
+        }
+        back_cursor_.store(0, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief Owns one EventQueue per registered event type.
+ *
+ * Queues are registered up front so lookups never mutate the
+ * map while systems are emitting.
+ */
+class EventBus {
+    std::unordered_map<std::type_index, std::unique_ptr<IEventQueue>> queues_{};
+
+public:
+    template<typename T>
+    void register_event(const std::size_t initial_capacity = 1024) {
+        const auto index = std::type_index(typeid(T));
+        assert(!queues_.contains(index) && "Event type already registered");
+        queues_[index] = std::make_unique<EventQueue<T>>(initial_capacity);
+    }
+
+    template<typename T>
+    [[nodiscard]] EventQueue<T>& get_queue() noexcept {
+        const auto index = std::type_index(typeid(T));
+        assert(queues_.contains(index) && "Event type not registered");
+        return static_cast<EventQueue<T>&>(*queues_.at(index));
+    }
+
+    template<typename T>
+    [[nodiscard]] const EventQueue<T>& get_queue() const noexcept {
+        const auto index = std::type_index(typeid(T));
+        assert(queues_.contains(index) && "Event type not registered");
+        return static_cast<const EventQueue<T>&>(*queues_.at(index));
+    }
+
+    /**
+     * @brief Flips every queue. Must run while no producer is active.
+     */
+    void swap_buffers() {
+        for (const auto& [index, queue] : queues_) {
+            queue->swap_buffers();
+        }
+    }
+};
+
+}
+
+#endif//GAME_ECS_EVENT_BUS_HPP
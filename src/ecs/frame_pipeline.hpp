@@ -0,0 +1,270 @@
+#ifndef GAME_ECS_FRAME_PIPELINE_HPP
+#define GAME_ECS_FRAME_PIPELINE_HPP
+
+#include "ecs/component_array.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/job_system.hpp"
+#include "ecs/runtime_component.hpp"
+#include "ecs/view.hpp"
+#include "ecs/world.hpp"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Read-only copy of selected component pools at the end of a frame.
+ */
+class FrameSnapshot {
+    struct Pool {
+        std::unique_ptr<IComponentArray> array;
+        void (*capture)(const World& world, IComponentArray& target);
+    };
+
+    std::unordered_map<std::type_index, Pool> pools_{};
+    std::unordered_map<ComponentType, std::unique_ptr<RuntimeComponentArray>> runtime_pools_{};
+    EntityMask enabled_{};
+    std::uint64_t frame_{0};
+    float delta_{0.0f};
+
+public:
+    /**
+     * @brief Adds a component type to the types copied by capture().
+     */
+    template<typename T>
+    void add_pool() {
+        static_assert(!ColdStorage<T>::value, "Capturing a cold component would decompress every page each frame");
+        const auto index = std::type_index(typeid(T));
+        assert(!pools_.contains(index) && "Component type already captured");
+        pools_.emplace(index, Pool{std::make_unique<ComponentArray<T>>(), [](const World& world, IComponentArray& target) {
+            static_cast<ComponentArray<T>&>(target).copy_from(published<T>(world.get_component_array<T>()));
+        }});
+    }
+
+    /**
+     * @brief Adds a runtime component type to the types copied by capture().
+     * @param type ID returned by World::register_runtime_component()
+     */
+    void add_runtime_pool(const World& world, const ComponentType type) {
+        assert(!runtime_pools_.contains(type) && "Component type already captured");
+        runtime_pools_.emplace(type, std::make_unique<RuntimeComponentArray>(world.get_runtime_component_array(type).get_descriptor()));
+    }
+
+    /**
+     * @brief Copies every added pool from the world.
+     * @param frame Number of the frame being captured
+     * @param delta Time step of that frame
+     */
+    void capture(const World& world, const std::uint64_t frame, const float delta) {
+        for (auto& pool : pools_ | std::views::values) {
+            pool.capture(world, *pool.array);
+        }
+        for (const auto& [type, pool] : runtime_pools_) {
+            pool->copy_from(world.get_runtime_component_array(type));
+        }
+        enabled_ = world.get_enabled_mask();
+        frame_ = frame;
+        delta_ = delta;
+    }
+
+    /**
+     * @brief Entities enabled at capture time.
+     */
+    [[nodiscard]] const EntityMask& get_enabled_mask() const noexcept {
+        return enabled_;
+    }
+
+    [[nodiscard]] std::uint64_t get_frame() const noexcept {
+        return frame_;
+    }
+
+    [[nodiscard]] float get_delta() const noexcept {
+        return delta_;
+    }
+
+    template<typename T>
+    [[nodiscard]] const ComponentArray<T>& get_component_array() const noexcept {
+        const auto it = pools_.find(std::type_index(typeid(T)));
+        assert(it != pools_.end() && "Component type is not captured");
+        return static_cast<const ComponentArray<T>&>(*it->second.array);
+    }
+
+    [[nodiscard]] const RuntimeComponentArray& get_runtime_component_array(const ComponentType type) const noexcept {
+        const auto it = runtime_pools_.find(type);
+        assert(it != runtime_pools_.end() && "Component type is not captured");
+        return *it->second;
+    }
+
+    [[nodiscard]] const std::byte* get_runtime_component(const Entity entity, const ComponentType type) const noexcept {
+        return get_runtime_component_array(type).get(entity);
+    }
+
+    [[nodiscard]] bool has_runtime_component(const Entity entity, const ComponentType type) const noexcept {
+        return get_runtime_component_array(type).has(entity);
+    }
+
+    template<typename T>
+    [[nodiscard]] const T& get_component(const Entity entity) const noexcept {
+        return get_component_array<T>().get(entity);
+    }
+
+    template<typename T>
+    [[nodiscard]] bool has_component(const Entity entity) const noexcept {
+        return get_component_array<T>().has(entity);
+    }
+
+    /**
+     * @brief Joins captured pools, skipping disabled entities; see World::view().
+     */
+    template<typename... Ts>
+    [[nodiscard]] View<const Ts...> view() const noexcept {
+        View<const Ts...> view(get_component_array<Ts>()...);
+        view.set_enabled_mask(&enabled_);
+        return view;
+    }
+};
+
+/**
+ * @brief Read-only system run on a FrameSnapshot after simulation.
+ *
+ * For render extraction, network send and other work that only
+ * consumes the results of a frame. It must not touch the World.
+ */
+struct LateSystem {
+    virtual ~LateSystem() = default;
+
+    /**
+     * @brief Called once per frame with that frame's snapshot.
+     */
+    virtual void tick(const FrameSnapshot& frame) = 0;
+};
+
+/**
+ * @brief Runs World::tick() followed by late systems, optionally overlapped.
+ *
+ * After each simulation tick the pools the late systems read are copied
+ * into the back snapshot. Without pipelining the late systems then run
+ * on it before tick() returns. With pipelining they are handed to the
+ * job system, and tick() returns at once so the next simulation tick
+ * runs while they work on the previous frame; the two snapshots
+ * alternate, so capturing frame N + 1 never waits for the late systems
+ * of frame N to finish reading. Late systems of consecutive frames never
+ * overlap each other, and they see frames in order, one frame behind.
+ *
+ * Pipelining needs a JobSystem with at least two workers; with one, the
+ * late stage only runs when the owning thread next waits.
+ */
+class FramePipeline {
+    World& world_;
+    JobSystem& jobs_;
+    std::array<FrameSnapshot, 2> snapshots_{};
+    std::size_t back_{0};
+    std::vector<std::unique_ptr<LateSystem>> systems_{};
+    JobCounter in_flight_{};
+    std::uint64_t frame_{0};
+    bool pipelined_{true};
+
+public:
+    FramePipeline(World& world, JobSystem& jobs) noexcept : world_(world), jobs_(jobs) {}
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    ~FramePipeline() {
+        flush();
+    }
+
+    /**
+     * @brief Adds component types late systems read to the snapshots.
+     */
+    template<typename... Ts>
+    void capture_components() {
+        flush();
+        for (auto& snapshot : snapshots_) {
+            (snapshot.add_pool<Ts>(), ...);
+        }
+    }
+
+    /**
+     * @brief Adds a runtime component type late systems read to the snapshots.
+     * @param type ID returned by World::register_runtime_component()
+     */
+    void capture_runtime_component(const ComponentType type) {
+        flush();
+        for (auto& snapshot : snapshots_) {
+            snapshot.add_runtime_pool(world_, type);
+        }
+    }
+
+    /**
+     * @brief Adds a late system; late systems run in the order they were added.
+     */
+    template<typename T, typename... Args>
+    [[nodiscard]] T& add_system(Args&&... args) {
+        static_assert(std::is_base_of_v<LateSystem, T>, "T must inherit LateSystem");
+        flush();
+        auto system = std::make_unique<T>(std::forward<Args>(args)...);
+        auto& system_ref = *system;
+        systems_.push_back(std::move(system));
+        return system_ref;
+    }
+
+    void set_pipelined(const bool pipelined) {
+        flush();
+        pipelined_ = pipelined;
+    }
+
+    [[nodiscard]] bool is_pipelined() const noexcept {
+        return pipelined_;
+    }
+
+    /**
+     * @brief Simulates one frame and starts (or runs) its late stage.
+     * @param delta Time elapsed since last frame
+     */
+    void tick(const float delta) {
+        world_.tick(delta);
+
+        auto& snapshot = snapshots_[back_];
+        snapshot.capture(world_, frame_++, delta);
+        back_ ^= 1;
+
+        // The late stage of the previous frame is still reading the other snapshot
+        flush();
+
+        if (pipelined_) {
+            jobs_.spawn([this, &snapshot] { run_late(snapshot); }, in_flight_);
+        } else {
+            run_late(snapshot);
+        }
+    }
+
+    /**
+     * @brief Waits until the late stage of the last frame has finished.
+     *
+     * Call before touching state late systems write, e.g. on shutdown.
+     */
+    void flush() {
+        jobs_.wait(in_flight_);
+    }
+
+private:
+    void run_late(const FrameSnapshot& snapshot) {
+        for (const auto& system : systems_) {
+            system->tick(snapshot);
+        }
+    }
+};
+
+}
+
+#endif//GAME_ECS_FRAME_PIPELINE_HPP
@@ -0,0 +1,34 @@
+#ifndef GAME_ECS_HASHING_HPP
+#define GAME_ECS_HASHING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace game::ecs {
+
+/**
+ * @brief splitmix64 finalizer; spreads every input bit over the result.
+ */
+constexpr std::uint64_t mix_hash(std::uint64_t value) noexcept {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief FNV-1a over a byte range.
+ */
+inline std::uint64_t hash_bytes(const void* data, const std::size_t size) noexcept {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+}
+
+#endif//GAME_ECS_HASHING_HPP
@@ -0,0 +1,444 @@
+#ifndef GAME_ECS_JOB_SYSTEM_HPP
+#define GAME_ECS_JOB_SYSTEM_HPP
+
+#include "ecs/cache.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Counts unfinished jobs; JobSystem::wait() returns once it reaches zero.
+ */
+struct JobCounter {
+    std::atomic<std::size_t> pending{0};
+
+    [[nodiscard]] bool done() const noexcept {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+};
+
+/**
+ * @brief Unit of work queued on a JobSystem.
+ *
+ * Line-aligned: jobs sit next to each other in their spawner's ring but
+ * are released by whichever worker ran them.
+ */
+struct alignas(CACHE_LINE_SIZE) Job {
+    std::function<void()> work{};
+    JobCounter* counter{nullptr};
+    std::atomic<bool> in_use{false};
+};
+
+/**
+ * @brief Chase-Lev work-stealing deque of jobs.
+ *
+ * The owning worker pushes and pops at the bottom (LIFO, so it keeps
+ * working on what it just split off while that is still in cache);
+ * other workers steal from the top (FIFO, so they take the oldest and
+ * usually largest pieces). Capacity is fixed; push() fails when full
+ * and the caller runs the job itself.
+ */
+class WorkStealingDeque {
+    static constexpr std::size_t CAPACITY = 4096;
+    static constexpr std::size_t MASK = CAPACITY - 1;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> top_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom_{0};
+    alignas(CACHE_LINE_SIZE) std::array<std::atomic<Job*>, CAPACITY> buffer_{};
+
+public:
+    /**
+     * @brief Pushes a job; owner only.
+     * @return False if the deque is full
+     */
+    bool push(Job* job) noexcept {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<std::int64_t>(CAPACITY)) {
+            return false;
+        }
+        buffer_[static_cast<std::size_t>(bottom) & MASK].store(job, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Pops the newest job; owner only.
+     * @return The job, or nullptr if empty or a thief took the last one
+     */
+    Job* pop() noexcept {
+        const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = buffer_[static_cast<std::size_t>(bottom) & MASK].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last job: race thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    /**
+     * @brief Takes the oldest job; any thread.
+     * @return The job, or nullptr if empty or another thread won the race
+     */
+    Job* steal() noexcept {
+        auto top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        Job* job = buffer_[static_cast<std::size_t>(top) & MASK].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return job;
+    }
+
+    /**
+     * @brief Approximate number of queued jobs.
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+};
+
+/**
+ * @brief Tasks with dependencies, run as a whole by JobSystem::run().
+ *
+ * A task starts once every task added as its predecessor has finished;
+ * tasks without predecessors start immediately. The graph must be
+ * acyclic and can be run again after it completes.
+ */
+class TaskGraph {
+    friend class JobSystem;
+
+    struct Node {
+        std::function<void()> work{};
+        std::vector<std::size_t> successors{};
+        std::uint32_t predecessor_count{0};
+        std::atomic<std::uint32_t> remaining{0};
+    };
+
+    std::deque<Node> nodes_{};
+
+public:
+    using TaskId = std::size_t;
+
+    TaskId add(std::function<void()> work) {
+        auto& node = nodes_.emplace_back();
+        node.work = std::move(work);
+        return nodes_.size() - 1;
+    }
+
+    /**
+     * @brief Makes after wait for before.
+     */
+    void precede(const TaskId before, const TaskId after) {
+        assert(before < nodes_.size() && after < nodes_.size() && before != after && "Invalid task dependency");
+        nodes_[before].successors.push_back(after);
+        ++nodes_[after].predecessor_count;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return nodes_.size();
+    }
+};
+
+/**
+ * @brief Work-stealing job scheduler.
+ *
+ * Runs worker_count - 1 threads; the thread that constructed the system
+ * is worker 0 and executes jobs while it waits. Every worker owns a
+ * WorkStealingDeque; spawned jobs go to the spawning worker's deque and
+ * idle workers steal from the others, sleeping only once every deque is
+ * empty. wait() never blocks while any job is runnable: it executes
+ * queued jobs, including unrelated ones, until its counter drops to zero.
+ *
+ * Jobs may only be spawned and waited for from worker threads and the
+ * owning thread. Blocking I/O should stay on dedicated threads, as it
+ * would stall a worker.
+ */
+class JobSystem {
+    static constexpr std::size_t JOBS_PER_WORKER = 4096;
+
+    // Deque and job ring of one worker; line-aligned since each is written by its owner
+    struct alignas(CACHE_LINE_SIZE) Worker {
+        WorkStealingDeque deque{};
+        std::unique_ptr<Job[]> jobs{std::make_unique<Job[]>(JOBS_PER_WORKER)};
+        std::size_t next_job{0};
+        std::uint64_t steal_seed{0};
+    };
+
+    static inline thread_local const JobSystem* current_system_{nullptr};
+    static inline thread_local std::size_t current_worker_{0};
+
+    std::vector<std::unique_ptr<Worker>> workers_{};
+    std::vector<std::thread> threads_{};
+    std::thread::id owner_thread_{std::this_thread::get_id()};
+
+    CachePadded<std::atomic<std::size_t>> queued_{};
+    CachePadded<std::atomic<std::size_t>> sleeping_{};
+    std::mutex sleep_mutex_{};
+    std::condition_variable wake_{};
+    bool stopping_{false};
+
+public:
+    /**
+     * @param worker_count Total workers, including the owning thread
+     */
+    explicit JobSystem(const std::size_t worker_count = std::thread::hardware_concurrency()) {
+        const auto count = std::max<std::size_t>(worker_count, 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->steal_seed = i * 0x9E3779B97F4A7C15ull + 1;
+        }
+        for (std::size_t i = 1; i < count; ++i) {
+            threads_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    ~JobSystem() {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    [[nodiscard]] std::size_t get_worker_count() const noexcept {
+        return workers_.size();
+    }
+
+    /**
+     * @brief Index of the calling worker, 0 for the owning thread.
+     */
+    [[nodiscard]] std::size_t current_worker() const noexcept {
+        if (current_system_ == this) {
+            return current_worker_;
+        }
+        assert(std::this_thread::get_id() == owner_thread_ && "Thread is not a worker of this job system");
+        return 0;
+    }
+
+    /**
+     * @brief Queues a job on the calling worker.
+     * @param work Function to run
+     * @param counter Incremented now and decremented once work has run
+     */
+    void spawn(std::function<void()> work, JobCounter& counter) {
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+        const auto worker = current_worker();
+        Job* job = allocate_job(worker);
+        job->work = std::move(work);
+        job->counter = &counter;
+
+        // Counted before the push so a thief never sees the count go below zero
+        queued_->fetch_add(1, std::memory_order_seq_cst);
+        if (!workers_[worker]->deque.push(job)) {
+            queued_->fetch_sub(1, std::memory_order_relaxed);
+            execute(job);
+            return;
+        }
+        if (sleeping_->load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard lock(sleep_mutex_);
+            wake_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Runs queued jobs until counter reaches zero.
+     */
+    void wait(const JobCounter& counter) {
+        const auto worker = current_worker();
+        while (!counter.done()) {
+            if (Job* job = find_job(worker)) {
+                execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Runs every task of a graph in dependency order and waits.
+     */
+    void run(TaskGraph& graph) {
+        if (graph.nodes_.empty()) {
+            return;
+        }
+
+        JobCounter counter;
+        for (auto& node : graph.nodes_) {
+            node.remaining.store(node.predecessor_count, std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < graph.nodes_.size(); ++i) {
+            if (graph.nodes_[i].predecessor_count == 0) {
+                spawn_task(graph, i, counter);
+            }
+        }
+        wait(counter);
+    }
+
+    /**
+     * @brief Runs body(begin, end, worker) over [0, count) and waits.
+     *
+     * Chunking adapts to load by lazy binary splitting: a worker
+     * processes its range grain elements at a time and, whenever its
+     * deque has run empty (the pending half was stolen or finished),
+     * splits off the upper half of what remains as a new job. Busy
+     * workers therefore rarely split, while idle workers always find
+     * large pieces to steal. The body receives the index of the worker
+     * running it, for per-worker scratch buffers.
+     *
+     * @param grain Smallest chunk handed to body; 0 picks one from count and worker count
+     */
+    template<typename F>
+    void parallel_for(const std::size_t count, std::size_t grain, F&& body) {
+        if (count == 0) {
+            return;
+        }
+        if (grain == 0) {
+            grain = std::max<std::size_t>(1, count / (workers_.size() * 64));
+        }
+
+        JobCounter counter;
+        run_range(0, count, grain, body, counter);
+        wait(counter);
+    }
+
+private:
+    template<typename F>
+    void run_range(std::size_t begin, std::size_t end, const std::size_t grain, F& body, JobCounter& counter) {
+        const auto worker = current_worker();
+        auto& deque = workers_[worker]->deque;
+
+        while (begin < end) {
+            if (end - begin > grain && deque.size() == 0) {
+                const auto middle = begin + (end - begin) / 2;
+                spawn([this, middle, end, grain, &body, &counter] { run_range(middle, end, grain, body, counter); }, counter);
+                end = middle;
+                continue;
+            }
+
+            const auto chunk_end = std::min(begin + grain, end);
+            body(begin, chunk_end, worker);
+            begin = chunk_end;
+        }
+    }
+
+    void spawn_task(TaskGraph& graph, const std::size_t index, JobCounter& counter) {
+        spawn([this, &graph, index, &counter] {
+            auto& node = graph.nodes_[index];
+            node.work();
+            for (const auto successor : node.successors) {
+                if (graph.nodes_[successor].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    spawn_task(graph, successor, counter);
+                }
+            }
+        }, counter);
+    }
+
+    Job* allocate_job(const std::size_t worker) {
+        auto& owner = *workers_[worker];
+        while (true) {
+            Job* job = &owner.jobs[owner.next_job];
+            owner.next_job = (owner.next_job + 1) & (JOBS_PER_WORKER - 1);
+            if (!job->in_use.load(std::memory_order_acquire)) {
+                job->in_use.store(true, std::memory_order_relaxed);
+                return job;
+            }
+            // Ring is full of unfinished jobs; help until one frees up
+            if (Job* other = find_job(worker)) {
+                execute(other);
+            }
+        }
+    }
+
+    void execute(Job* job) {
+        job->work();
+        job->work = nullptr;
+        auto* counter = job->counter;
+        job->in_use.store(false, std::memory_order_release);
+        counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    Job* find_job(const std::size_t worker) noexcept {
+        auto& self = *workers_[worker];
+        Job* job = self.deque.pop();
+        if (job == nullptr && workers_.size() > 1) {
+            // Start at a random victim so thieves spread over the workers
+            self.steal_seed ^= self.steal_seed << 13;
+            self.steal_seed ^= self.steal_seed >> 7;
+            self.steal_seed ^= self.steal_seed << 17;
+            const auto start = static_cast<std::size_t>(self.steal_seed % workers_.size());
+            for (std::size_t i = 0; i < workers_.size() && job == nullptr; ++i) {
+                const auto victim = (start + i) % workers_.size();
+                if (victim != worker) {
+                    job = workers_[victim]->deque.steal();
+                }
+            }
+        }
+        if (job != nullptr) {
+            queued_->fetch_sub(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    void worker_loop(const std::size_t worker) {
+        current_system_ = this;
+        current_worker_ = worker;
+
+        while (true) {
+            if (Job* job = find_job(worker)) {
+                execute(job);
+                continue;
+            }
+
+            std::unique_lock lock(sleep_mutex_);
+            sleeping_->fetch_add(1, std::memory_order_seq_cst);
+            wake_.wait(lock, [this] { return stopping_ || queued_->load(std::memory_order_seq_cst) != 0; });
+            sleeping_->fetch_sub(1, std::memory_order_relaxed);
+            if (stopping_) {
+                return;
+            }
+        }
+    }
+};
+
+}
+
+#endif//GAME_ECS_JOB_SYSTEM_HPP
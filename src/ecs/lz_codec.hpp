@@ -0,0 +1,199 @@
+#ifndef GAME_ECS_LZ_CODEC_HPP
+#define GAME_ECS_LZ_CODEC_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Byte-oriented LZ77 codec in the style of LZ4, for in-memory pages.
+ *
+ * The stream is a list of sequences: a token byte (literal count in the
+ * high nibble, match length - 4 in the low one, 15 meaning more length
+ * bytes follow), the literals, a 2-byte little-endian match offset and
+ * the extra match length bytes. The last sequence has literals only.
+ * Matches are found with a single-entry hash table of 4-byte prefixes,
+ * so compression is one pass with no entropy coding: fast, and good on
+ * repetitive component data such as defaults, zeros and small integers.
+ */
+namespace lz {
+
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t MAX_OFFSET = 65535;
+constexpr std::size_t HASH_BITS = 10;
+
+namespace detail {
+
+[[nodiscard]] inline std::uint32_t read32(const std::byte* data) noexcept {
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Length of the common run of input[a...] and input[b...], with b > a, 8 bytes at a time.
+ */
+[[nodiscard]] inline std::size_t common_prefix(const std::span<const std::byte> input, const std::size_t a, const std::size_t b) noexcept {
+    std::size_t length = 0;
+    while (b + length + sizeof(std::uint64_t) <= input.size()) {
+        std::uint64_t x;
+        std::uint64_t y;
+        std::memcpy(&x, input.data() + a + length, sizeof(x));
+        std::memcpy(&y, input.data() + b + length, sizeof(y));
+        if (const auto diff = x ^ y; diff != 0) {
+            const auto bits = std::endian::native == std::endian::little ? std::countr_zero(diff) : std::countl_zero(diff);
+            return length + static_cast<std::size_t>(bits) / 8;
+        }
+        length += sizeof(std::uint64_t);
+    }
+    while (b + length < input.size() && input[a + length] == input[b + length]) {
+        ++length;
+    }
+    return length;
+}
+
+[[nodiscard]] inline std::size_t hash(const std::uint32_t value) noexcept {
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+inline void write_length(std::vector<std::byte>& out, std::size_t length) {
+    for (; length >= 255; length -= 255) {
+        out.push_back(std::byte{255});
+    }
+    out.push_back(static_cast<std::byte>(length));
+}
+
+inline void write_sequence(std::vector<std::byte>& out, const std::span<const std::byte> literals,
+                           const std::size_t offset, const std::size_t match_length) {
+    const auto extra_match = match_length - MIN_MATCH;
+    const auto literal_nibble = literals.size() < 15 ? literals.size() : 15;
+    const auto match_nibble = offset == 0 ? 0 : (extra_match < 15 ? extra_match : 15);
+    out.push_back(static_cast<std::byte>(literal_nibble << 4 | match_nibble));
+    if (literal_nibble == 15) {
+        write_length(out, literals.size() - 15);
+    }
+    out.insert(out.end(), literals.begin(), literals.end());
+
+    // The last sequence carries no match
+    if (offset != 0) {
+        out.push_back(static_cast<std::byte>(offset & 0xff));
+        out.push_back(static_cast<std::byte>(offset >> 8));
+        if (match_nibble == 15) {
+            write_length(out, extra_match - 15);
+        }
+    }
+}
+
+[[nodiscard]] inline bool read_length(const std::span<const std::byte> in, std::size_t& in_pos, std::size_t& length) noexcept {
+    std::byte extra{255};
+    while (extra == std::byte{255}) {
+        if (in_pos >= in.size()) {
+            return false;
+        }
+        extra = in[in_pos++];
+        length += static_cast<std::size_t>(extra);
+    }
+    return true;
+}
+
+}
+
+/**
+ * @brief Compresses a buffer.
+ * @param input Bytes to compress
+ * @return The compressed stream
+ */
+[[nodiscard]] inline std::vector<std::byte> compress(const std::span<const std::byte> input) {
+    std::vector<std::byte> out;
+    out.reserve(input.size() / 2 + 16);
+
+    // Positions + 1, so 0 means empty
+    std::array<std::uint32_t, std::size_t{1} << HASH_BITS> table{};
+    std::size_t anchor = 0;
+    std::size_t pos = 0;
+    while (pos + MIN_MATCH <= input.size()) {
+        const auto value = detail::read32(input.data() + pos);
+        auto& slot = table[detail::hash(value)];
+        const std::size_t candidate = slot;
+        slot = static_cast<std::uint32_t>(pos + 1);
+
+        if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || detail::read32(input.data() + candidate - 1) != value) {
+            ++pos;
+            continue;
+        }
+
+        const auto match = candidate - 1;
+        const auto length = MIN_MATCH + detail::common_prefix(input, match + MIN_MATCH, pos + MIN_MATCH);
+        detail::write_sequence(out, input.subspan(anchor, pos - anchor), pos - match, length);
+        pos += length;
+        anchor = pos;
+    }
+    detail::write_sequence(out, input.subspan(anchor), 0, MIN_MATCH);
+    return out;
+}
+
+/**
+ * @brief Decompresses a stream produced by compress().
+ * @param input The compressed stream
+ * @param output Buffer for the original bytes
+ * @return Number of bytes written, or 0 if the stream is malformed or does not fit
+ */
+[[nodiscard]] inline std::size_t decompress(const std::span<const std::byte> input, const std::span<std::byte> output) noexcept {
+    std::size_t in_pos = 0;
+    std::size_t out_pos = 0;
+    while (in_pos < input.size()) {
+        const auto token = static_cast<std::size_t>(input[in_pos++]);
+
+        auto literals = token >> 4;
+        if (literals == 15 && !detail::read_length(input, in_pos, literals)) {
+            return 0;
+        }
+        if (literals > input.size() - in_pos || literals > output.size() - out_pos) {
+            return 0;
+        }
+        std::memcpy(output.data() + out_pos, input.data() + in_pos, literals);
+        in_pos += literals;
+        out_pos += literals;
+
+        if (in_pos == input.size()) {
+            break;
+        }
+
+        if (input.size() - in_pos < 2) {
+            return 0;
+        }
+        const auto offset = static_cast<std::size_t>(input[in_pos]) | static_cast<std::size_t>(input[in_pos + 1]) << 8;
+        in_pos += 2;
+        auto length = token & 15;
+        if (length == 15 && !detail::read_length(input, in_pos, length)) {
+            return 0;
+        }
+        length += MIN_MATCH;
+        if (offset == 0 || offset > out_pos || length > output.size() - out_pos) {
+            return 0;
+        }
+
+        if (offset >= length) {
+            std::memcpy(output.data() + out_pos, output.data() + out_pos - offset, length);
+            out_pos += length;
+        } else {
+            // Byte by byte: the match overlaps the bytes it produces
+            for (std::size_t i = 0; i < length; ++i, ++out_pos) {
+                output[out_pos] = output[out_pos - offset];
+            }
+        }
+    }
+    return out_pos;
+}
+
+}
+
+}
+
+#endif//GAME_ECS_LZ_CODEC_HPP
@@ -0,0 +1,499 @@
+#ifndef GAME_ECS_MAPPED_WORLD_IMAGE_HPP
+#define GAME_ECS_MAPPED_WORLD_IMAGE_HPP
+
+#include "ecs/component_storage.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_bitset.hpp"
+#include "ecs/entity_manager.hpp"
+#include "ecs/reflection.hpp"
+#include "ecs/serialization.hpp"
+#include "ecs/world.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace game::ecs {
+
+/**
+ * @brief Memory-mapped image of a World for fast warm restarts.
+ *
+ * The file holds a versioned header followed by two checkpoint slots.
+ * Each slot stores the signature table, the entity recycling queue, the
+ * enabled mask and the dense pools of every registered component type. A checkpoint is
+ * written into the older slot, flushed with msync, and only then made
+ * current by bumping its generation and checksum in the header. A crash
+ * mid-checkpoint therefore leaves the previous slot intact.
+ *
+ * Checkpointing copies each trivially copyable pool with one memcpy.
+ * Restoring re-adds every checkpointed component of the newest valid
+ * slot to an empty World with add_component(), so signatures, system
+ * membership and observers are rebuilt exactly as for live adds; no
+ * format conversion or database rebuild is involved.
+ * Components that are not trivially copyable, such as ones holding
+ * strings, must be reflected; each is stored as a serialize_component()
+ * record in a fixed-capacity cell, and a checkpoint fails rather than
+ * truncating a record that does not fit.
+ *
+ * Requires POSIX mmap/msync.
+ */
+class MappedWorldImage {
+    static_assert(MAX_COMPONENT_TYPES <= 64, "Signatures are stored as 64-bit words");
+
+    static constexpr std::uint64_t IMAGE_MAGIC = 0x474D495343455FULL;  // "_ECSIMG"
+    static constexpr std::uint32_t LAYOUT_VERSION = 3;
+    static constexpr std::size_t HEADER_SIZE = 4096;
+    static constexpr std::size_t PAGE_SIZE = 4096;
+
+public:
+    /// Default cell size, length prefix included, of serialized components
+    static constexpr std::uint32_t DEFAULT_RECORD_CAPACITY = 256;
+
+private:
+    struct PoolDescriptor {
+        std::uint32_t stable_id;
+        std::uint32_t element_size;
+        std::uint32_t alignment;
+        std::uint32_t reserved;
+    };
+
+    struct ImageHeader {
+        std::uint64_t magic;
+        std::uint32_t layout_version;
+        std::uint32_t pool_count;
+        std::uint64_t max_entities;
+        std::uint64_t slot_size;
+        std::uint64_t generation[2];
+        std::uint64_t checksum[2];
+        PoolDescriptor pools[MAX_COMPONENT_TYPES];
+    };
+    static_assert(sizeof(ImageHeader) <= HEADER_SIZE, "Image header must fit in its page");
+
+    struct SlotHeader {
+        std::uint64_t available_count;
+        std::uint64_t pool_sizes[MAX_COMPONENT_TYPES];
+    };
+
+    struct PoolCodec {
+        PoolDescriptor descriptor;
+        ComponentType type;
+        std::size_t entities_offset;
+        std::size_t data_offset;
+        /// Returns the number of elements written, or nullopt if one did not fit its cell
+        std::optional<std::size_t> (*save)(const World&, ComponentType, std::uint32_t, Entity*, std::byte*);
+        void (*restore)(World&, ComponentType, std::uint32_t, const Entity*, const std::byte*, std::size_t);
+    };
+
+    World& world_;
+    std::vector<PoolCodec> codecs_{};
+    Signature covered_{};
+    std::size_t signatures_offset_{0};
+    std::size_t available_offset_{0};
+    std::size_t enabled_offset_{0};
+    std::size_t slot_size_{0};
+    std::size_t mapping_size_{0};
+    std::byte* mapping_{nullptr};
+    int fd_{-1};
+
+public:
+    explicit MappedWorldImage(World& world) : world_(world) {}
+
+    MappedWorldImage(const MappedWorldImage&) = delete;
+    MappedWorldImage& operator=(const MappedWorldImage&) = delete;
+
+    ~MappedWorldImage() {
+        close();
+    }
+
+    /**
+     * @brief Registers a component pool to persist. Call before open().
+     * @tparam T A trivially copyable or reflected component type
+     * @param stable_id ID recorded in the layout header; must not change between builds
+     * @param record_capacity Cell size for types that are not trivially copyable
+     */
+    template<typename T>
+    void register_component(const std::uint32_t stable_id, const std::uint32_t record_capacity = DEFAULT_RECORD_CAPACITY) {
+        static_assert(std::is_trivially_copyable_v<T> || Reflected<T>,
+                      "Persisted components must be trivially copyable or reflected");
+        assert(mapping_ == nullptr && "Components must be registered before the image is opened");
+        assert(codecs_.size() < MAX_COMPONENT_TYPES && "Too many persisted component types");
+
+        const auto type = world_.get_component_type<T>();
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            codecs_.push_back(PoolCodec{
+                PoolDescriptor{stable_id, sizeof(T), alignof(T), 0},
+                type,
+                0,
+                0,
+                [](const World& world, ComponentType, std::uint32_t, Entity* entities, std::byte* data) -> std::optional<std::size_t> {
+                    // The back buffer of double-buffered pools, so writes not yet published are kept
+                    const auto& pool = latest<T>(world.get_component_array<T>());
+                    if constexpr (ColdStorage<T>::value) {
+                        // No contiguous storage; cold pages are read without thawing them
+                        pool.for_each_page([&](const std::size_t first, const std::span<const T> page) {
+                            std::memcpy(data + first * sizeof(T), page.data(), page.size_bytes());
+                        });
+                    } else {
+                        std::memcpy(data, pool.data(), pool.size() * sizeof(T));
+                    }
+                    for (std::size_t i = 0; i < pool.size(); ++i) {
+                        entities[i] = pool.entity_at(i);
+                    }
+                    return pool.size();
+                },
+                [](World& world, ComponentType, std::uint32_t, const Entity* entities, const std::byte* data, const std::size_t count) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        T component;
+                        std::memcpy(&component, data + i * sizeof(T), sizeof(T));
+                        world.add_component(entities[i], std::move(component));
+                    }
+                }
+            });
+        } else {
+            assert(record_capacity > sizeof(std::uint32_t) && "Record cells need room past the length prefix");
+            codecs_.push_back(PoolCodec{
+                PoolDescriptor{stable_id, record_capacity, alignof(std::uint32_t), 0},
+                type,
+                0,
+                0,
+                [](const World& world, ComponentType, const std::uint32_t cell_size, Entity* entities,
+                   std::byte* data) -> std::optional<std::size_t> {
+                    const auto& pool = latest<T>(world.get_component_array<T>());
+                    BinaryWriter record;
+                    for (std::size_t i = 0; i < pool.size(); ++i) {
+                        record.clear();
+                        serialize_component(record, pool.data()[i]);
+                        const auto length = static_cast<std::uint32_t>(record.size());
+                        if (record.size() > cell_size - sizeof(length)) {
+                            return std::nullopt;
+                        }
+                        std::byte* cell = data + i * cell_size;
+                        std::memcpy(cell, &length, sizeof(length));
+                        std::memcpy(cell + sizeof(length), record.bytes().data(), length);
+                        entities[i] = pool.entity_at(i);
+                    }
+                    return pool.size();
+                },
+                [](World& world, ComponentType, const std::uint32_t cell_size, const Entity* entities,
+                   const std::byte* data, const std::size_t count) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        const std::byte* cell = data + i * cell_size;
+                        std::uint32_t length = 0;
+                        std::memcpy(&length, cell, sizeof(length));
+                        BinaryReader in({cell + sizeof(length), std::min<std::size_t>(length, cell_size - sizeof(length))});
+                        T component{};
+                        const bool decoded = deserialize_component(in, component) && in.remaining() == 0;
+                        assert(decoded && "Checkpointed record does not decode");
+                        if (decoded) {
+                            world.add_component(entities[i], std::move(component));
+                        }
+                    }
+                }
+            });
+        }
+        covered_.set(type, true);
+    }
+
+    /**
+     * @brief Registers a runtime component pool to persist. Call before open().
+     * @param type ID returned by World::register_runtime_component()
+     * @param stable_id ID recorded in the layout header; must not change between builds
+     */
+    void register_runtime_component(const ComponentType type, const std::uint32_t stable_id) {
+        assert(mapping_ == nullptr && "Components must be registered before the image is opened");
+        assert(codecs_.size() < MAX_COMPONENT_TYPES && "Too many persisted component types");
+
+        const auto& descriptor = world_.get_runtime_component_array(type).get_descriptor();
+        codecs_.push_back(PoolCodec{
+            PoolDescriptor{stable_id, descriptor.size, descriptor.alignment, 0},
+            type,
+            0,
+            0,
+            [](const World& world, const ComponentType type, std::uint32_t, Entity* entities, std::byte* data) -> std::optional<std::size_t> {
+                const auto& pool = world.get_runtime_component_array(type);
+                const auto size = pool.get_descriptor().size;
+                for (std::size_t i = 0; i < pool.size(); ++i) {
+                    std::memcpy(data + i * size, pool.data() + i * pool.get_stride(), size);
+                    entities[i] = pool.entity_at(i);
+                }
+                return pool.size();
+            },
+            [](World& world, const ComponentType type, std::uint32_t, const Entity* entities, const std::byte* data, const std::size_t count) {
+                const auto size = world.get_runtime_component_array(type).get_descriptor().size;
+                for (std::size_t i = 0; i < count; ++i) {
+                    world.add_runtime_component(entities[i], type, data + i * size);
+                }
+            }
+        });
+        covered_.set(type, true);
+    }
+
+    /**
+     * @brief Maps the image file, creating or re-initializing it if needed.
+     *
+     * A file whose header does not match the registered layout is
+     * reset, which discards its checkpoints.
+     *
+     * @param path Location of the image file
+     * @return True if the file could be mapped
+     */
+    bool open(const std::filesystem::path& path) noexcept {
+        assert(mapping_ == nullptr && "Image is already open");
+        compute_layout();
+
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            return false;
+        }
+
+        struct stat info{};
+        if (::fstat(fd_, &info) != 0
+            || (static_cast<std::size_t>(info.st_size) != mapping_size_
+                && ::ftruncate(fd_, static_cast<off_t>(mapping_size_)) != 0)) {
+            close();
+            return false;
+        }
+
+        void* mapping = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            close();
+            return false;
+        }
+        mapping_ = static_cast<std::byte*>(mapping);
+
+        if (!header_matches_layout()) {
+            initialize_header();
+        }
+        return true;
+    }
+
+    void close() noexcept {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mapping_size_);
+            mapping_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    /**
+     * @brief Whether the image holds at least one complete checkpoint.
+     */
+    [[nodiscard]] bool has_checkpoint() const noexcept {
+        return mapping_ != nullptr && newest_valid_slot() >= 0;
+    }
+
+    /**
+     * @brief Writes the current World state into the older slot and publishes it.
+     *
+     * Meant to be called periodically, e.g. once per second, at a
+     * point where no system is mutating the World. Double-buffered
+     * pools are saved from their back buffer, so writes made this frame
+     * are captured even before World::tick() publishes them.
+     *
+     * @return True once the checkpoint is durable on disk; false if a sync
+     *         failed or a serialized record outgrew its cell
+     */
+    bool checkpoint() noexcept {
+        assert(mapping_ != nullptr && "Image is not open");
+
+        auto* header = get_header();
+        const int target = header->generation[0] <= header->generation[1] ? 0 : 1;
+        std::byte* slot = get_slot(target);
+
+        auto* slot_header = reinterpret_cast<SlotHeader*>(slot);
+        auto* signatures = reinterpret_cast<std::uint64_t*>(slot + signatures_offset_);
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            signatures[entity] = world_.get_signature(entity).to_ullong();
+        }
+
+        const auto available = world_.get_available_entities();
+        std::memcpy(slot + available_offset_, available.data(), available.size() * sizeof(Entity));
+        slot_header->available_count = available.size();
+
+        const auto& enabled = world_.get_enabled_mask().words();
+        std::memcpy(slot + enabled_offset_, enabled.data(), sizeof(enabled));
+
+        for (std::size_t i = 0; i < codecs_.size(); ++i) {
+            const auto& codec = codecs_[i];
+            const auto count = codec.save(
+                world_,
+                codec.type,
+                codec.descriptor.element_size,
+                reinterpret_cast<Entity*>(slot + codec.entities_offset),
+                slot + codec.data_offset);
+            // The newer slot is untouched, so failing here loses nothing
+            if (!count) {
+                return false;
+            }
+            slot_header->pool_sizes[i] = *count;
+        }
+
+        // The slot must be durable before the header points at it
+        if (::msync(slot, slot_size_, MS_SYNC) != 0) {
+            return false;
+        }
+
+        header->checksum[target] = checksum(slot);
+        header->generation[target] = std::max(header->generation[0], header->generation[1]) + 1;
+        return ::msync(mapping_, HEADER_SIZE, MS_SYNC) == 0;
+    }
+
+    /**
+     * @brief Rebuilds an empty World from the newest valid checkpoint.
+     * @return False if the image holds no valid checkpoint
+     */
+    bool restore() noexcept {
+        assert(mapping_ != nullptr && "Image is not open");
+        assert(world_.get_entity_count() == 0 && "Can only restore into an empty world");
+
+        const int source = newest_valid_slot();
+        if (source < 0) {
+            return false;
+        }
+
+        const std::byte* slot = get_slot(source);
+        const auto* slot_header = reinterpret_cast<const SlotHeader*>(slot);
+        const auto* available = reinterpret_cast<const Entity*>(slot + available_offset_);
+        world_.restore_available_entities({available, static_cast<std::size_t>(slot_header->available_count)});
+
+        // Restored IDs come back enabled; disable the ones that were paused at checkpoint time
+        const auto* enabled = reinterpret_cast<const std::uint64_t*>(slot + enabled_offset_);
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            if (world_.is_entity_enabled(entity) && (enabled[entity / 64] & (std::uint64_t{1} << (entity % 64))) == 0) {
+                world_.set_entity_enabled(entity, false);
+            }
+        }
+
+        for (std::size_t i = 0; i < codecs_.size(); ++i) {
+            const auto& codec = codecs_[i];
+            codec.restore(
+                world_,
+                codec.type,
+                codec.descriptor.element_size,
+                reinterpret_cast<const Entity*>(slot + codec.entities_offset),
+                slot + codec.data_offset,
+                static_cast<std::size_t>(slot_header->pool_sizes[i]));
+        }
+
+#ifndef NDEBUG
+        const auto* signatures = reinterpret_cast<const std::uint64_t*>(slot + signatures_offset_);
+        for (Entity entity = 0; entity < MAX_ENTITIES; ++entity) {
+            assert(world_.get_signature(entity) == (Signature(signatures[entity]) & covered_)
+                   && "Restored signature does not match the checkpoint");
+        }
+#endif
+
+        return true;
+    }
+
+private:
+    static std::size_t align_up(const std::size_t value, const std::size_t alignment) noexcept {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void compute_layout() noexcept {
+        std::size_t offset = align_up(sizeof(SlotHeader), 64);
+        signatures_offset_ = offset;
+        offset += MAX_ENTITIES * sizeof(std::uint64_t);
+        available_offset_ = offset;
+        offset += MAX_ENTITIES * sizeof(Entity);
+        enabled_offset_ = offset;
+        offset += EntityMask::WORD_COUNT * sizeof(std::uint64_t);
+
+        for (auto& codec : codecs_) {
+            codec.entities_offset = offset;
+            offset += MAX_ENTITIES * sizeof(Entity);
+            offset = align_up(offset, std::max<std::size_t>(codec.descriptor.alignment, 64));
+            codec.data_offset = offset;
+            offset += MAX_ENTITIES * codec.descriptor.element_size;
+        }
+
+        // Page-aligned slots so each one can be flushed on its own
+        slot_size_ = align_up(offset, PAGE_SIZE);
+        mapping_size_ = HEADER_SIZE + 2 * slot_size_;
+    }
+
+    [[nodiscard]] ImageHeader* get_header() const noexcept {
+        return reinterpret_cast<ImageHeader*>(mapping_);
+    }
+
+    [[nodiscard]] std::byte* get_slot(const int slot) const noexcept {
+        return mapping_ + HEADER_SIZE + static_cast<std::size_t>(slot) * slot_size_;
+    }
+
+    [[nodiscard]] bool header_matches_layout() const noexcept {
+        const auto* header = get_header();
+        if (header->magic != IMAGE_MAGIC || header->layout_version != LAYOUT_VERSION
+            || header->max_entities != MAX_ENTITIES || header->slot_size != slot_size_
+            || header->pool_count != codecs_.size()) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < codecs_.size(); ++i) {
+            const auto& expected = codecs_[i].descriptor;
+            const auto& actual = header->pools[i];
+            if (expected.stable_id != actual.stable_id || expected.element_size != actual.element_size
+                || expected.alignment != actual.alignment) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void initialize_header() noexcept {
+        auto* header = get_header();
+        std::memset(header, 0, HEADER_SIZE);
+        header->magic = IMAGE_MAGIC;
+        header->layout_version = LAYOUT_VERSION;
+        header->pool_count = static_cast<std::uint32_t>(codecs_.size());
+        header->max_entities = MAX_ENTITIES;
+        header->slot_size = slot_size_;
+        for (std::size_t i = 0; i < codecs_.size(); ++i) {
+            header->pools[i] = codecs_[i].descriptor;
+        }
+        ::msync(mapping_, HEADER_SIZE, MS_SYNC);
+    }
+
+    [[nodiscard]] int newest_valid_slot() const noexcept {
+        const auto* header = get_header();
+        int newest = -1;
+        for (int slot = 0; slot < 2; ++slot) {
+            if (header->generation[slot] == 0 || header->checksum[slot] != checksum(get_slot(slot))) {
+                continue;
+            }
+            if (newest < 0 || header->generation[slot] > header->generation[newest]) {
+                newest = slot;
+            }
+        }
+        return newest;
+    }
+
+    /**
+     * @brief FNV-1a over a whole slot, used to detect torn checkpoints.
+     */
+    [[nodiscard]] std::uint64_t checksum(const std::byte* slot) const noexcept {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        for (std::size_t i = 0; i < slot_size_; ++i) {
+            hash ^= static_cast<std::uint64_t>(slot[i]);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+};
+
+}
+
+#endif//GAME_ECS_MAPPED_WORLD_IMAGE_HPP
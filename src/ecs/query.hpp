@@ -0,0 +1,44 @@
+#ifndef GAME_ECS_QUERY_HPP
+#define GAME_ECS_QUERY_HPP
+
+#include "ecs/entity_manager.hpp"
+
+namespace game::ecs {
+
+/**
+ * @brief Component types an entity must not have to match a signature or view.
+ */
+template<typename... Ts>
+struct Without {};
+
+/**
+ * @brief Component types a signature or view uses when present.
+ *
+ * They never decide whether an entity matches; views yield them as
+ * pointers that are null for entities lacking the component.
+ */
+template<typename... Ts>
+struct Optional {};
+
+/**
+ * @brief Signature with required, excluded and optional component types.
+ *
+ * Built by World::make_filter() from a list of terms, e.g.
+ * make_filter<Health, Without<PlayerControlled>, Optional<Sprite>>().
+ */
+struct SignatureFilter {
+    Signature include{};
+    Signature exclude{};
+    Signature optional{};
+
+    /**
+     * @brief Whether an entity with the given signature matches.
+     */
+    [[nodiscard]] bool matches(const Signature& signature) const noexcept {
+        return (signature & include) == include && (signature & exclude).none();
+    }
+};
+
+}
+
+#endif//GAME_ECS_QUERY_HPP
@@ -0,0 +1,324 @@
+#ifndef GAME_ECS_REFLECTION_HPP
+#define GAME_ECS_REFLECTION_HPP
+
+#include "ecs/serialization.hpp"
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace game::ecs {
+
+/**
+ * @brief One reflected data member: its name and member pointer.
+ */
+template<typename Class, typename Member>
+struct Field {
+    using class_type = Class;
+    using member_type = Member;
+
+    std::string_view name;
+    Member Class::* pointer;
+
+    [[nodiscard]] constexpr const Member& get(const Class& object) const noexcept {
+        return object.*pointer;
+    }
+
+    [[nodiscard]] constexpr Member& get(Class& object) const noexcept {
+        return object.*pointer;
+    }
+};
+
+/**
+ * @brief Reflection metadata of a type; specialized by ECS_REFLECT.
+ *
+ * A specialization provides `name` and a constexpr tuple of Field
+ * descriptors named `fields`. Everything below is generated per type
+ * from that tuple by fold expressions, so each field access is a direct
+ * member access with no virtual dispatch.
+ */
+template<typename T>
+struct Reflect;
+
+template<typename T>
+concept Reflected = requires {
+    Reflect<T>::name;
+    Reflect<T>::fields;
+};
+
+template<Reflected T>
+inline constexpr std::size_t field_count_v = std::tuple_size_v<std::remove_cvref_t<decltype(Reflect<T>::fields)>>;
+
+/**
+ * @brief Calls f(field) for every reflected field of T, in declaration order.
+ */
+template<Reflected T, typename F>
+constexpr void for_each_field(F&& f) {
+    std::apply([&](const auto&... fields) { (f(fields), ...); }, Reflect<T>::fields);
+}
+
+/**
+ * @brief Calls f(field, index) for every reflected field of T.
+ */
+template<Reflected T, typename F>
+constexpr void for_each_field_indexed(F&& f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::get<I>(Reflect<T>::fields), I), ...);
+    }(std::make_index_sequence<field_count_v<T>>{});
+}
+
+/**
+ * @brief Whether every byte of a T belongs to a member, so equal values hash equal byte-wise.
+ *
+ * Arithmetic and enum types qualify. Reflected types qualify when their
+ * fields qualify and fill the whole object; any other type must have
+ * unique object representations.
+ */
+template<typename T>
+[[nodiscard]] constexpr bool is_padding_free() noexcept {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        return true;
+    } else if constexpr (Reflected<T>) {
+        std::size_t field_bytes = 0;
+        bool fields_padding_free = true;
+        for_each_field<T>([&](const auto& field) {
+            using Member = typename std::remove_cvref_t<decltype(field)>::member_type;
+            field_bytes += sizeof(Member);
+            fields_padding_free = fields_padding_free && is_padding_free<Member>();
+        });
+        return fields_padding_free && field_bytes == sizeof(T);
+    } else {
+        return std::has_unique_object_representations_v<T>;
+    }
+}
+
+namespace detail {
+
+/**
+ * @brief Drops namespace qualifiers from a type name written in ECS_REFLECT.
+ */
+constexpr std::string_view unqualified(const std::string_view name) noexcept {
+    const auto separator = name.rfind("::");
+    return separator == std::string_view::npos ? name : name.substr(separator + 2);
+}
+
+template<typename T>
+void write_value(BinaryWriter& out, const T& value);
+
+template<typename T>
+bool read_value(BinaryReader& in, T& value);
+
+template<typename T>
+bool values_equal(const T& a, const T& b);
+
+template<typename T>
+void dump_value(std::ostream& out, const T& value);
+
+}
+
+/**
+ * @brief Writes every reflected field of a value.
+ *
+ * Trivially copyable fields are written as raw bytes, strings as a
+ * length prefix plus characters, and reflected members recursively.
+ */
+template<Reflected T>
+void serialize(BinaryWriter& out, const T& value) {
+    for_each_field<T>([&](const auto& field) {
+        detail::write_value(out, field.get(value));
+    });
+}
+
+/**
+ * @brief Reads a value written by serialize().
+ * @return False if the input ran out; the value is then partially updated
+ */
+template<Reflected T>
+bool deserialize(BinaryReader& in, T& value) {
+    for_each_field<T>([&](const auto& field) {
+        detail::read_value(in, field.get(value));
+    });
+    return in.ok();
+}
+
+/**
+ * @brief Bit i is set when field i differs between a and b.
+ */
+template<Reflected T>
+[[nodiscard]] std::bitset<field_count_v<T>> changed_fields(const T& a, const T& b) {
+    std::bitset<field_count_v<T>> changed;
+    for_each_field_indexed<T>([&](const auto& field, const std::size_t index) {
+        changed.set(index, !detail::values_equal(field.get(a), field.get(b)));
+    });
+    return changed;
+}
+
+/**
+ * @brief Writes only the fields of current that differ from base.
+ *
+ * The record is a 64-bit changed-field mask followed by the changed
+ * fields in declaration order.
+ *
+ * @return True if any field changed; nothing is written otherwise
+ */
+template<Reflected T>
+bool encode_delta(BinaryWriter& out, const T& base, const T& current) {
+    static_assert(field_count_v<T> <= 64, "Delta masks hold at most 64 fields");
+
+    const auto changed = changed_fields(base, current);
+    if (changed.none()) {
+        return false;
+    }
+
+    out.write(static_cast<std::uint64_t>(changed.to_ullong()));
+    for_each_field_indexed<T>([&](const auto& field, const std::size_t index) {
+        if (changed.test(index)) {
+            detail::write_value(out, field.get(current));
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Applies a record written by encode_delta() on top of the base value.
+ * @return False if the input ran out
+ */
+template<Reflected T>
+bool apply_delta(BinaryReader& in, T& value) {
+    std::uint64_t mask = 0;
+    if (!in.read(mask)) {
+        return false;
+    }
+
+    for_each_field_indexed<T>([&](const auto& field, const std::size_t index) {
+        if ((mask >> index) & 1) {
+            detail::read_value(in, field.get(value));
+        }
+    });
+    return in.ok();
+}
+
+/**
+ * @brief Writes a whole component for persistence.
+ *
+ * Reflected types go through serialize(), so they may hold strings;
+ * other types must be trivially copyable and are written as raw bytes.
+ */
+template<typename T>
+void serialize_component(BinaryWriter& out, const T& value) {
+    detail::write_value(out, value);
+}
+
+/**
+ * @brief Reads a component written by serialize_component().
+ * @return False if the input ran out
+ */
+template<typename T>
+bool deserialize_component(BinaryReader& in, T& value) {
+    detail::read_value(in, value);
+    return in.ok();
+}
+
+/**
+ * @brief Prints a value as `Name{field=value, ...}` for logs and tools.
+ */
+template<Reflected T>
+void dump(std::ostream& out, const T& value) {
+    out << Reflect<T>::name << '{';
+    for_each_field_indexed<T>([&](const auto& field, const std::size_t index) {
+        out << (index == 0 ? "" : ", ") << field.name << '=';
+        detail::dump_value(out, field.get(value));
+    });
+    out << '}';
+}
+
+namespace detail {
+
+template<typename T>
+void write_value(BinaryWriter& out, const T& value) {
+    if constexpr (Reflected<T>) {
+        serialize(out, value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        out.write(static_cast<std::uint32_t>(value.size()));
+        out.write_bytes(value.data(), value.size());
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>, "Field type cannot be serialized");
+        out.write(value);
+    }
+}
+
+template<typename T>
+bool read_value(BinaryReader& in, T& value) {
+    if constexpr (Reflected<T>) {
+        return deserialize(in, value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        std::uint32_t size = 0;
+        in.read(size);
+        const auto bytes = in.take(size);
+        if (!in.ok()) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        return true;
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>, "Field type cannot be deserialized");
+        return in.read(value);
+    }
+}
+
+template<typename T>
+bool values_equal(const T& a, const T& b) {
+    if constexpr (Reflected<T>) {
+        return changed_fields(a, b).none();
+    } else {
+        return a == b;
+    }
+}
+
+template<typename T>
+void dump_value(std::ostream& out, const T& value) {
+    if constexpr (Reflected<T>) {
+        dump(out, value);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        out << '"' << value << '"';
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out << (value ? "true" : "false");
+    } else {
+        out << value;
+    }
+}
+
+}
+
+}
+
+#define ECS_REFLECT_PARENS ()
+#define ECS_REFLECT_EXPAND(...) ECS_REFLECT_EXPAND3(ECS_REFLECT_EXPAND3(ECS_REFLECT_EXPAND3(ECS_REFLECT_EXPAND3(__VA_ARGS__))))
+#define ECS_REFLECT_EXPAND3(...) ECS_REFLECT_EXPAND2(ECS_REFLECT_EXPAND2(ECS_REFLECT_EXPAND2(ECS_REFLECT_EXPAND2(__VA_ARGS__))))
+#define ECS_REFLECT_EXPAND2(...) ECS_REFLECT_EXPAND1(ECS_REFLECT_EXPAND1(ECS_REFLECT_EXPAND1(ECS_REFLECT_EXPAND1(__VA_ARGS__))))
+#define ECS_REFLECT_EXPAND1(...) __VA_ARGS__
+
+#define ECS_REFLECT_FIELDS(Type, ...) __VA_OPT__(ECS_REFLECT_EXPAND(ECS_REFLECT_FIELDS_HELPER(Type, __VA_ARGS__)))
+#define ECS_REFLECT_FIELDS_HELPER(Type, member, ...) \
+    , std::make_tuple(::game::ecs::Field<Type, decltype(Type::member)>{#member, &Type::member}) \
+    __VA_OPT__(ECS_REFLECT_FIELDS_AGAIN ECS_REFLECT_PARENS (Type, __VA_ARGS__))
+#define ECS_REFLECT_FIELDS_AGAIN() ECS_REFLECT_FIELDS_HELPER
+
+/**
+ * @brief Declares the reflected fields of a type. Use at global scope.
+ *
+ * Example: ECS_REFLECT(game::example::Health, current, maximum)
+ */
+#define ECS_REFLECT(Type, ...)                                                              \
+    template<>                                                                              \
+    struct game::ecs::Reflect<Type> {                                                       \
+        static constexpr std::string_view name = ::game::ecs::detail::unqualified(#Type);  \
+        static constexpr auto fields = std::tuple_cat(std::tuple<>{} ECS_REFLECT_FIELDS(Type, __VA_ARGS__)); \
+    };
+
+#endif//GAME_ECS_REFLECTION_HPP
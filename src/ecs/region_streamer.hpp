@@ -0,0 +1,576 @@
+#ifndef GAME_ECS_REGION_STREAMER_HPP
+#define GAME_ECS_REGION_STREAMER_HPP
+
+#include "ecs/component_storage.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_manager.hpp"
+#include "ecs/reflection.hpp"
+#include "ecs/serialization.hpp"
+#include "ecs/world.hpp"
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace game::ecs {
+
+/**
+ * @brief Identifier of a streamable region of the world.
+ */
+using RegionId = std::uint32_t;
+
+/**
+ * @brief Component tagging an entity as belonging to a streamable region.
+ *
+ * Must be registered like any other component before a
+ * RegionStreamer is constructed.
+ */
+struct Region {
+    RegionId id{0};
+
+    Region() = default;
+    explicit Region(RegionId region) : id(region) {}
+};
+
+/**
+ * @brief Streams whole regions of entities out to disk and back.
+ *
+ * Evicting a region serializes every entity tagged with it into a
+ * compact binary page and removes the entities from the World. The
+ * page is written by a background I/O thread to a temporary file,
+ * fsynced and renamed over the previous page, so a crash mid-write
+ * leaves the last good page in place. The streamer keeps the page in
+ * memory until commit() sees the write succeed; a failed write keeps
+ * it there, and loads of a region whose page is not yet on disk are
+ * served from that copy. Loading otherwise reads the page on the I/O
+ * thread; the entities are only recreated when commit() is called at
+ * a sync point, with a per-call entity budget so large regions can be
+ * spread over several frames.
+ *
+ * Only components registered with the streamer are stored, and a
+ * region holding an entity with an unregistered component is refused.
+ * Reflected components are written with serialize_component(), so they
+ * may hold strings; others must be trivially copyable.
+ * Loaded pages are validated in full before any entity is created, so
+ * a truncated or corrupt page leaves the region evicted. Entity IDs are
+ * not preserved, so streamed components must not reference other
+ * entities by ID.
+ */
+class RegionStreamer {
+public:
+    enum class RegionState {
+        Resident,
+        Evicted,
+        Loading,
+        Committing
+    };
+
+private:
+    static constexpr std::uint32_t PAGE_MAGIC = 0x52534345;  // "ECSR"
+    static constexpr std::uint32_t PAGE_VERSION = 2;
+
+    struct ComponentCodec {
+        std::uint32_t stable_id;
+        ComponentType type;
+        void (*save)(const World&, ComponentType, Entity, BinaryWriter&);
+        /// Whether bytes decode to exactly one component; runs before any entity is created
+        bool (*check)(const World&, ComponentType, std::span<const std::byte>);
+        void (*load)(World&, ComponentType, Entity, std::span<const std::byte>);
+    };
+
+    using PageBytes = std::shared_ptr<const std::vector<std::byte>>;
+
+    struct IoRequest {
+        bool is_write{false};
+        RegionId region{0};
+        PageBytes bytes{};
+    };
+
+    struct WrittenPage {
+        RegionId region{0};
+        bool ok{false};
+        PageBytes bytes{};
+    };
+
+    struct LoadedPage {
+        RegionId region{0};
+        bool ok{false};
+        std::vector<std::byte> bytes{};
+    };
+
+    struct StagedPage {
+        RegionId region{0};
+        std::vector<std::byte> bytes{};
+        BinaryReader reader{};
+        std::uint32_t remaining{0};
+    };
+
+    World& world_;
+    std::filesystem::path directory_;
+    std::vector<ComponentCodec> codecs_{};
+    std::unordered_map<std::uint32_t, std::size_t> codec_by_stable_id_{};
+    Signature covered_{};
+    std::unordered_map<RegionId, RegionState> states_{};
+    std::deque<StagedPage> staged_{};
+    // Pages not yet known to be on disk; the only copy of their region
+    std::unordered_map<RegionId, PageBytes> unwritten_{};
+
+    std::thread io_thread_;
+    std::mutex io_mutex_{};
+    std::condition_variable io_condition_{};
+    std::deque<IoRequest> io_requests_{};
+    std::vector<LoadedPage> loaded_{};
+    std::vector<WrittenPage> written_{};
+    std::atomic<std::size_t> failed_writes_{0};
+    std::size_t failed_loads_{0};
+    bool stopping_{false};
+
+public:
+    RegionStreamer(World& world, std::filesystem::path directory)
+        : world_(world), directory_(std::move(directory)) {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        covered_.set(world_.get_component_type<Region>(), true);
+        io_thread_ = std::thread([this] { io_loop(); });
+    }
+
+    RegionStreamer(const RegionStreamer&) = delete;
+    RegionStreamer& operator=(const RegionStreamer&) = delete;
+
+    /**
+     * @brief Flushes outstanding writes and stops the I/O thread.
+     */
+    ~RegionStreamer() {
+        {
+            std::lock_guard lock(io_mutex_);
+            stopping_ = true;
+        }
+        io_condition_.notify_one();
+        io_thread_.join();
+    }
+
+    /**
+     * @brief Registers a component type to be stored in region pages.
+     * @tparam T A reflected or trivially copyable component type
+     * @param stable_id ID written to disk; must not change between builds
+     */
+    template<typename T>
+    void register_component(const std::uint32_t stable_id) {
+        static_assert(Reflected<T> || std::is_trivially_copyable_v<T>,
+                      "Streamed components must be reflected or trivially copyable");
+
+        add_codec(ComponentCodec{
+            stable_id,
+            world_.get_component_type<T>(),
+            [](const World& world, ComponentType, const Entity entity, BinaryWriter& out) {
+                serialize_component(out, latest<T>(world.get_component_array<T>()).get(entity));
+            },
+            [](const World&, ComponentType, const std::span<const std::byte> bytes) {
+                BinaryReader in(bytes);
+                T component{};
+                return deserialize_component(in, component) && in.remaining() == 0;
+            },
+            [](World& world, ComponentType, const Entity entity, const std::span<const std::byte> bytes) {
+                BinaryReader in(bytes);
+                T component{};
+                deserialize_component(in, component);
+                world.add_component(entity, std::move(component));
+            }
+        });
+    }
+
+    /**
+     * @brief Registers a runtime component type to be stored in region pages.
+     * @param type ID returned by World::register_runtime_component()
+     * @param stable_id ID written to disk; must not change between builds
+     */
+    void register_runtime_component(const ComponentType type, const std::uint32_t stable_id) {
+        add_codec(ComponentCodec{
+            stable_id,
+            type,
+            [](const World& world, const ComponentType type, const Entity entity, BinaryWriter& out) {
+                out.write_bytes(world.get_runtime_component(entity, type),
+                                world.get_runtime_component_array(type).get_descriptor().size);
+            },
+            [](const World& world, const ComponentType type, const std::span<const std::byte> bytes) {
+                return bytes.size() == world.get_runtime_component_array(type).get_descriptor().size;
+            },
+            [](World& world, const ComponentType type, const Entity entity, const std::span<const std::byte> bytes) {
+                world.add_runtime_component(entity, type, bytes.data());
+            }
+        });
+    }
+
+    /**
+     * @brief Serializes a region and removes its entities from the World.
+     *
+     * Serialization happens in memory on the calling thread; the disk
+     * write is queued for the I/O thread and the page is kept in memory
+     * until it succeeds. Nothing is evicted if any member carries a
+     * component the streamer cannot store.
+     *
+     * @param region The region to evict
+     * @return Number of entities evicted, or nullopt if the region was refused
+     */
+    std::optional<std::size_t> evict_region(const RegionId region) {
+        assert(get_state(region) == RegionState::Resident && "Region is not resident");
+
+        const auto& tags = world_.get_component_array<Region>();
+        std::vector<Entity> members;
+        for (std::size_t i = 0; i < tags.size(); ++i) {
+            if (tags.data()[i].id == region) {
+                members.push_back(tags.entity_at(i));
+            }
+        }
+
+        for (const auto entity : members) {
+            if ((world_.get_signature(entity) & ~covered_).any()) {
+                return std::nullopt;
+            }
+        }
+
+        BinaryWriter page;
+        BinaryWriter component;
+        page.write(PAGE_MAGIC);
+        page.write(PAGE_VERSION);
+        page.write(region);
+        page.write(static_cast<std::uint32_t>(members.size()));
+
+        for (const auto entity : members) {
+            const auto& signature = world_.get_signature(entity);
+            std::uint32_t component_count = 0;
+            for (const auto& codec : codecs_) {
+                component_count += signature.test(codec.type) ? 1 : 0;
+            }
+
+            page.write(component_count);
+            for (const auto& codec : codecs_) {
+                if (signature.test(codec.type)) {
+                    component.clear();
+                    codec.save(world_, codec.type, entity, component);
+                    page.write(codec.stable_id);
+                    page.write(static_cast<std::uint32_t>(component.size()));
+                    page.write_bytes(component.bytes().data(), component.size());
+                }
+            }
+        }
+
+        for (const auto entity : members) {
+            world_.remove_entity(entity);
+        }
+
+        auto bytes = std::make_shared<const std::vector<std::byte>>(page.release());
+        unwritten_[region] = bytes;
+        states_[region] = RegionState::Evicted;
+        submit(IoRequest{true, region, std::move(bytes)});
+        return members.size();
+    }
+
+    /**
+     * @brief Starts reading an evicted region back on the I/O thread.
+     *
+     * A region whose page is not yet on disk is loaded from the copy
+     * kept in memory instead.
+     *
+     * @param region The region to load
+     */
+    void request_load(const RegionId region) {
+        assert(get_state(region) == RegionState::Evicted && "Region is not evicted");
+        states_[region] = RegionState::Loading;
+
+        // The staged copy becomes the region's only copy; any pending write of it is moot
+        if (const auto it = unwritten_.find(region); it != unwritten_.end()) {
+            LoadedPage page{region, true, *it->second};
+            unwritten_.erase(it);
+            std::lock_guard lock(io_mutex_);
+            loaded_.push_back(std::move(page));
+            return;
+        }
+        submit(IoRequest{false, region, {}});
+    }
+
+    /**
+     * @brief Recreates entities from pages that finished loading.
+     *
+     * Must be called from the thread that owns the World, at a point
+     * where structural changes are allowed.
+     *
+     * @param max_entities Upper bound on entities created by this call
+     * @return Number of entities created
+     */
+    std::size_t commit(std::size_t max_entities = MAX_ENTITIES) {
+        collect_written_pages();
+        collect_loaded_pages();
+
+        std::size_t created = 0;
+        while (created < max_entities && !staged_.empty()) {
+            auto& staged = staged_.front();
+
+            while (created < max_entities && staged.remaining > 0) {
+                restore_entity(staged);
+                --staged.remaining;
+                ++created;
+            }
+
+            if (staged.remaining == 0) {
+                states_[staged.region] = RegionState::Resident;
+                staged_.pop_front();
+            }
+        }
+
+        return created;
+    }
+
+    [[nodiscard]] RegionState get_state(const RegionId region) const noexcept {
+        const auto it = states_.find(region);
+        return it != states_.end() ? it->second : RegionState::Resident;
+    }
+
+    [[nodiscard]] bool is_resident(const RegionId region) const noexcept {
+        return get_state(region) == RegionState::Resident;
+    }
+
+    /**
+     * @brief Number of evicted regions whose page is only held in memory.
+     *
+     * Includes writes still in flight and writes that failed; updated by commit().
+     */
+    [[nodiscard]] std::size_t get_unwritten_region_count() const noexcept {
+        return unwritten_.size();
+    }
+
+    /**
+     * @brief Number of page writes that failed on the I/O thread.
+     *
+     * The pages of failed writes stay in memory, so their regions can
+     * still be loaded.
+     */
+    [[nodiscard]] std::size_t get_failed_write_count() const noexcept {
+        return failed_writes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of loaded pages rejected as unreadable, truncated or corrupt.
+     */
+    [[nodiscard]] std::size_t get_failed_load_count() const noexcept {
+        return failed_loads_;
+    }
+
+private:
+    [[nodiscard]] std::filesystem::path page_path(const RegionId region) const {
+        return directory_ / ("region_" + std::to_string(region) + ".bin");
+    }
+
+    void submit(IoRequest request) {
+        {
+            std::lock_guard lock(io_mutex_);
+            io_requests_.push_back(std::move(request));
+        }
+        io_condition_.notify_one();
+    }
+
+    void io_loop() {
+        while (true) {
+            IoRequest request;
+            {
+                std::unique_lock lock(io_mutex_);
+                io_condition_.wait(lock, [this] { return stopping_ || !io_requests_.empty(); });
+                if (io_requests_.empty()) {
+                    return;
+                }
+                request = std::move(io_requests_.front());
+                io_requests_.pop_front();
+            }
+
+            // Requests are served in order, so a load always sees the preceding eviction's write
+            if (request.is_write) {
+                const bool ok = write_page(page_path(request.region), *request.bytes);
+                if (!ok) {
+                    failed_writes_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                std::lock_guard lock(io_mutex_);
+                written_.push_back(WrittenPage{request.region, ok, std::move(request.bytes)});
+                continue;
+            }
+
+            LoadedPage page{request.region, false, {}};
+            if (std::ifstream file(page_path(request.region), std::ios::binary | std::ios::ate); file) {
+                page.bytes.resize(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0);
+                page.ok = static_cast<bool>(file.read(reinterpret_cast<char*>(page.bytes.data()),
+                                                      static_cast<std::streamsize>(page.bytes.size())));
+            }
+
+            std::lock_guard lock(io_mutex_);
+            loaded_.push_back(std::move(page));
+        }
+    }
+
+    /**
+     * @brief Writes a page next to its final path, syncs it, then renames it into place.
+     *
+     * Until the rename the previous page, if any, stays intact on disk.
+     */
+    static bool write_page(const std::filesystem::path& path, const std::vector<std::byte>& bytes) {
+        auto temporary = path;
+        temporary += ".tmp";
+
+        const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+
+        bool ok = true;
+        std::size_t written = 0;
+        while (ok && written < bytes.size()) {
+            const auto result = ::write(fd, bytes.data() + written, bytes.size() - written);
+            ok = result > 0;
+            written += ok ? static_cast<std::size_t>(result) : 0;
+        }
+        ok = ok && ::fsync(fd) == 0;
+        ok = ::close(fd) == 0 && ok;
+
+        if (!ok || ::rename(temporary.c_str(), path.c_str()) != 0) {
+            ::unlink(temporary.c_str());
+            return false;
+        }
+
+        // The rename is only durable once the directory entry is synced
+        const int directory = ::open(path.parent_path().c_str(), O_RDONLY | O_DIRECTORY);
+        if (directory < 0) {
+            return false;
+        }
+        ok = ::fsync(directory) == 0;
+        ::close(directory);
+        return ok;
+    }
+
+    /**
+     * @brief Drops the in-memory copy of pages that reached the disk.
+     */
+    void collect_written_pages() {
+        std::vector<WrittenPage> written;
+        {
+            std::lock_guard lock(io_mutex_);
+            written.swap(written_);
+        }
+
+        for (const auto& page : written) {
+            // A later eviction of the region may have replaced the page since
+            const auto it = unwritten_.find(page.region);
+            if (page.ok && it != unwritten_.end() && it->second == page.bytes) {
+                unwritten_.erase(it);
+            }
+        }
+    }
+
+    void collect_loaded_pages() {
+        std::vector<LoadedPage> loaded;
+        {
+            std::lock_guard lock(io_mutex_);
+            loaded.swap(loaded_);
+        }
+
+        for (auto& page : loaded) {
+            StagedPage staged{page.region, std::move(page.bytes), {}, 0};
+            staged.reader = BinaryReader(staged.bytes);
+
+            std::uint32_t magic = 0;
+            std::uint32_t version = 0;
+            RegionId region = 0;
+            staged.reader.read(magic);
+            staged.reader.read(version);
+            staged.reader.read(region);
+            staged.reader.read(staged.remaining);
+
+            if (!page.ok || !staged.reader.ok() || magic != PAGE_MAGIC
+                || version != PAGE_VERSION || region != page.region
+                || !validate_entities(staged.reader, staged.remaining)) {
+                // Leave the region evicted so the load can be retried
+                states_[page.region] = RegionState::Evicted;
+                ++failed_loads_;
+                continue;
+            }
+
+            states_[page.region] = RegionState::Committing;
+            staged_.push_back(std::move(staged));
+        }
+    }
+
+    /**
+     * @brief Walks every entity record of a page without touching the World.
+     *
+     * Takes the reader by value so the staged reader stays positioned at
+     * the first entity. The page must be consumed exactly, and every
+     * known component must decode.
+     */
+    [[nodiscard]] bool validate_entities(BinaryReader reader, const std::uint32_t entity_count) const {
+        for (std::uint32_t e = 0; e < entity_count && reader.ok(); ++e) {
+            std::uint32_t component_count = 0;
+            reader.read(component_count);
+            for (std::uint32_t i = 0; i < component_count && reader.ok(); ++i) {
+                std::uint32_t stable_id = 0;
+                std::uint32_t size = 0;
+                reader.read(stable_id);
+                reader.read(size);
+                const auto bytes = reader.take(size);
+
+                const auto it = codec_by_stable_id_.find(stable_id);
+                if (reader.ok() && it != codec_by_stable_id_.end()
+                    && !codecs_[it->second].check(world_, codecs_[it->second].type, bytes)) {
+                    return false;
+                }
+            }
+        }
+        return reader.ok() && reader.remaining() == 0;
+    }
+
+    void add_codec(const ComponentCodec& codec) {
+        assert(!codec_by_stable_id_.contains(codec.stable_id) && "Stable ID already registered");
+        codec_by_stable_id_[codec.stable_id] = codecs_.size();
+        codecs_.push_back(codec);
+        covered_.set(codec.type, true);
+    }
+
+    void restore_entity(StagedPage& staged) {
+        const Entity entity = world_.add_entity();
+        world_.add_component(entity, Region{staged.region});
+
+        std::uint32_t component_count = 0;
+        staged.reader.read(component_count);
+        for (std::uint32_t i = 0; i < component_count; ++i) {
+            std::uint32_t stable_id = 0;
+            std::uint32_t size = 0;
+            staged.reader.read(stable_id);
+            staged.reader.read(size);
+            const auto bytes = staged.reader.take(size);
+
+            // Unknown components are skipped; known ones were checked by validate_entities()
+            const auto it = codec_by_stable_id_.find(stable_id);
+            if (it != codec_by_stable_id_.end()) {
+                codecs_[it->second].load(world_, codecs_[it->second].type, entity, bytes);
+            }
+        }
+    }
+};
+
+}
+
+#endif//GAME_ECS_REGION_STREAMER_HPP
@@ -0,0 +1,323 @@
+#ifndef GAME_ECS_REPLAY_HPP
+#define GAME_ECS_REPLAY_HPP
+
+#include "ecs/cache.hpp"
+#include "ecs/component_manager.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_manager.hpp"
+#include "ecs/hashing.hpp"
+#include "ecs/reflection.hpp"
+#include "ecs/serialization.hpp"
+#include "ecs/world.hpp"
+#include "ecs/world_observer.hpp"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Per-tick world checksum built from component change stamps.
+ *
+ * Every structural change and every marked component write during a
+ * tick produces a stamp hashed from (kind, entity, component type,
+ * value). Stamps are summed, so the result does not depend on the order
+ * systems report them in, and end_tick() folds the sum into a running
+ * checksum. The cost is proportional to what changed, never to the size
+ * of the world.
+ *
+ * Writes through mutable get_component() are only seen when followed
+ * by World::mark_component_changed(). Values are hashed for tracked
+ * component types; other types only contribute entity and type.
+ * Values are hashed byte-wise, so track() rejects types with padding,
+ * whose indeterminate bytes would make checksums differ between runs.
+ */
+class ChangeChecksum final : public IWorldObserver {
+    static constexpr std::uint64_t NO_TYPE = MAX_COMPONENT_TYPES;
+
+    enum class StampKind : std::uint64_t {
+        EntityCreated = 1,
+        EntityDestroyed = 2,
+        ComponentAdded = 3,
+        ComponentRemoved = 4,
+        ComponentChanged = 5
+    };
+
+    World& world_;
+    std::array<std::uint32_t, MAX_COMPONENT_TYPES> tracked_sizes_{};
+    // Hammered by parallel systems; kept off the line of tracked_sizes_, which they read
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> tick_stamps_{0};
+    std::uint64_t checksum_{0};
+    std::uint64_t tick_{0};
+
+public:
+    explicit ChangeChecksum(World& world) : world_(world) {
+        world_.add_observer(this);
+    }
+
+    ChangeChecksum(const ChangeChecksum&) = delete;
+    ChangeChecksum& operator=(const ChangeChecksum&) = delete;
+
+    ~ChangeChecksum() override {
+        world_.remove_observer(this);
+    }
+
+    /**
+     * @brief Includes the value of a component type in its change stamps.
+     * @tparam T A trivially copyable component type without padding; see is_padding_free()
+     */
+    template<typename T>
+    void track() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable components can be hashed");
+        static_assert(is_padding_free<T>(), "Padding bytes of the component would make checksums nondeterministic");
+        tracked_sizes_[world_.get_component_type<T>()] = sizeof(T);
+    }
+
+    /**
+     * @brief Closes the current tick and returns the checksum up to it.
+     */
+    std::uint64_t end_tick() noexcept {
+        const auto stamps = tick_stamps_.exchange(0, std::memory_order_relaxed);
+        checksum_ = mix_hash(checksum_ ^ mix_hash(stamps + tick_));
+        ++tick_;
+        return checksum_;
+    }
+
+    [[nodiscard]] std::uint64_t get_checksum() const noexcept {
+        return checksum_;
+    }
+
+    void entity_created(const Entity entity) override {
+        stamp(StampKind::EntityCreated, entity, NO_TYPE, 0);
+    }
+
+    void entity_destroyed(const Entity entity, const Signature& signature) override {
+        stamp(StampKind::EntityDestroyed, entity, NO_TYPE, signature.to_ullong());
+    }
+
+    void component_added(const Entity entity, const ComponentType type, const void* component) override {
+        stamp(StampKind::ComponentAdded, entity, type, hash_value(type, component));
+    }
+
+    void component_removed(const Entity entity, const ComponentType type) override {
+        stamp(StampKind::ComponentRemoved, entity, type, 0);
+    }
+
+    void component_changed(const Entity entity, const ComponentType type, const void* component) override {
+        stamp(StampKind::ComponentChanged, entity, type, hash_value(type, component));
+    }
+
+private:
+    [[nodiscard]] std::uint64_t hash_value(const ComponentType type, const void* component) const noexcept {
+        return hash_bytes(component, tracked_sizes_[type]);
+    }
+
+    void stamp(const StampKind kind, const Entity entity, const std::uint64_t type, const std::uint64_t value) noexcept {
+        const auto key = mix_hash(static_cast<std::uint64_t>(kind) ^ mix_hash(entity ^ mix_hash(type ^ mix_hash(value))));
+        tick_stamps_.fetch_add(key, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Everything needed to re-run one simulation tick.
+ */
+struct ReplayTick {
+    struct Input {
+        std::uint32_t channel{0};
+        std::vector<std::byte> bytes{};
+    };
+
+    float delta{0.0f};
+    std::uint64_t seed{0};
+    std::uint64_t checksum{0};
+    std::vector<Input> inputs{};
+
+    /**
+     * @brief Reads the input recorded on a channel this tick.
+     * @return False if nothing of that size was recorded on the channel
+     */
+    template<typename T>
+    bool read_input(const std::uint32_t channel, T& out) const noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "Inputs must be trivially copyable");
+        for (const auto& input : inputs) {
+            if (input.channel == channel && input.bytes.size() == sizeof(T)) {
+                std::memcpy(&out, input.bytes.data(), sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Captures inputs, deltas, RNG seeds and checksums of a live session.
+ *
+ * Per tick: begin_tick(), record_input() for whatever the input systems
+ * consume, run the world, then end_tick() with the ChangeChecksum result.
+ */
+class ReplayRecorder {
+    static constexpr std::uint32_t REPLAY_MAGIC = 0x50524345;  // "ECRP"
+    static constexpr std::uint32_t REPLAY_VERSION = 1;
+
+    friend class ReplayDriver;
+
+    std::vector<ReplayTick> ticks_{};
+    ReplayTick current_{};
+    bool in_tick_{false};
+
+public:
+    void begin_tick(const float delta, const std::uint64_t seed) {
+        assert(!in_tick_ && "Previous tick was not ended");
+        current_ = ReplayTick{delta, seed, 0, {}};
+        in_tick_ = true;
+    }
+
+    template<typename T>
+    void record_input(const std::uint32_t channel, const T& input) {
+        static_assert(std::is_trivially_copyable_v<T>, "Inputs must be trivially copyable");
+        assert(in_tick_ && "Inputs must be recorded inside a tick");
+
+        ReplayTick::Input recorded{channel, std::vector<std::byte>(sizeof(T))};
+        std::memcpy(recorded.bytes.data(), &input, sizeof(T));
+        current_.inputs.push_back(std::move(recorded));
+    }
+
+    void end_tick(const std::uint64_t checksum) {
+        assert(in_tick_ && "No tick in progress");
+        current_.checksum = checksum;
+        ticks_.push_back(std::move(current_));
+        in_tick_ = false;
+    }
+
+    [[nodiscard]] const std::vector<ReplayTick>& get_ticks() const noexcept {
+        return ticks_;
+    }
+
+    bool save(const std::filesystem::path& path) const {
+        BinaryWriter out;
+        out.write(REPLAY_MAGIC);
+        out.write(REPLAY_VERSION);
+        out.write(static_cast<std::uint64_t>(ticks_.size()));
+
+        for (const auto& tick : ticks_) {
+            out.write(tick.delta);
+            out.write(tick.seed);
+            out.write(tick.checksum);
+            out.write(static_cast<std::uint32_t>(tick.inputs.size()));
+            for (const auto& input : tick.inputs) {
+                out.write(input.channel);
+                out.write(static_cast<std::uint32_t>(input.bytes.size()));
+                out.write_bytes(input.bytes.data(), input.bytes.size());
+            }
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(out.bytes().data()), static_cast<std::streamsize>(out.size()));
+        return static_cast<bool>(file);
+    }
+};
+
+/**
+ * @brief Re-runs a recorded session headless and checks it tick by tick.
+ */
+class ReplayDriver {
+    std::vector<ReplayTick> ticks_{};
+
+public:
+    struct Result {
+        std::size_t ticks_run{0};
+        std::optional<std::size_t> first_desync_tick{};
+    };
+
+    ReplayDriver() = default;
+    explicit ReplayDriver(std::vector<ReplayTick> ticks) : ticks_(std::move(ticks)) {}
+
+    bool load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        std::vector<std::byte> bytes(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        BinaryReader in(bytes);
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::uint64_t tick_count = 0;
+        in.read(magic);
+        in.read(version);
+        in.read(tick_count);
+        if (!in.ok() || magic != ReplayRecorder::REPLAY_MAGIC || version != ReplayRecorder::REPLAY_VERSION) {
+            return false;
+        }
+
+        std::vector<ReplayTick> ticks;
+        for (std::uint64_t i = 0; i < tick_count && in.ok(); ++i) {
+            ReplayTick tick;
+            std::uint32_t input_count = 0;
+            in.read(tick.delta);
+            in.read(tick.seed);
+            in.read(tick.checksum);
+            in.read(input_count);
+            for (std::uint32_t j = 0; j < input_count && in.ok(); ++j) {
+                ReplayTick::Input input;
+                std::uint32_t size = 0;
+                in.read(input.channel);
+                in.read(size);
+                const auto payload = in.take(size);
+                input.bytes.assign(payload.begin(), payload.end());
+                tick.inputs.push_back(std::move(input));
+            }
+            ticks.push_back(std::move(tick));
+        }
+
+        if (!in.ok()) {
+            return false;
+        }
+        ticks_ = std::move(ticks);
+        return true;
+    }
+
+    [[nodiscard]] const std::vector<ReplayTick>& get_ticks() const noexcept {
+        return ticks_;
+    }
+
+    /**
+     * @brief Runs every recorded tick as fast as possible.
+     *
+     * The world must be in the state the recording started from, with
+     * the checksum attached and tracking the same component types.
+     *
+     * @param world World to simulate
+     * @param checksum Checksum observing the world
+     * @param apply_tick Called before each tick to feed inputs and reseed RNGs
+     * @return Ticks run and the first tick whose checksum diverged, if any
+     */
+    template<typename ApplyTick>
+    Result run(World& world, ChangeChecksum& checksum, ApplyTick&& apply_tick) {
+        for (std::size_t i = 0; i < ticks_.size(); ++i) {
+            const auto& tick = ticks_[i];
+            apply_tick(tick);
+            world.tick(tick.delta);
+
+            if (checksum.end_tick() != tick.checksum) {
+                return Result{i + 1, i};
+            }
+        }
+        return Result{ticks_.size(), std::nullopt};
+    }
+};
+
+}
+
+#endif//GAME_ECS_REPLAY_HPP
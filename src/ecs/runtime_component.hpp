@@ -0,0 +1,358 @@
+#ifndef GAME_ECS_RUNTIME_COMPONENT_HPP
+#define GAME_ECS_RUNTIME_COMPONENT_HPP
+
+#include "ecs/cache.hpp"
+#include "ecs/component_array.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_bitset.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Primitive types a runtime component field can hold.
+ */
+enum class FieldType : std::uint8_t {
+    Bool,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float32,
+    Float64,
+    Entity,
+    Bytes  // Opaque blob of FieldDescriptor::size bytes
+};
+
+/**
+ * @brief Location and type of one field inside a runtime component.
+ */
+struct FieldDescriptor {
+    std::string name{};
+    FieldType type{FieldType::Bytes};
+    std::uint32_t offset{0};
+    std::uint32_t size{0};
+};
+
+/**
+ * @brief Memory layout of a component type defined at load time.
+ *
+ * Built from data (e.g. a mod's schema) instead of a C++ type. The
+ * component is plain bytes: it must be valid when zero-filled and is
+ * copied with memcpy.
+ */
+struct ComponentDescriptor {
+    std::string name{};
+    std::uint32_t size{0};
+    std::uint32_t alignment{alignof(std::max_align_t)};
+    std::vector<FieldDescriptor> fields{};
+
+    /**
+     * @brief Looks up a field by name.
+     * @return The field, or nullptr if the component has none by that name
+     */
+    [[nodiscard]] const FieldDescriptor* find_field(const std::string& field_name) const noexcept {
+        const auto it = std::find_if(fields.begin(), fields.end(), [&](const auto& field) {
+            return field.name == field_name;
+        });
+        return it != fields.end() ? &*it : nullptr;
+    }
+};
+
+/**
+ * @brief Largest alignment a runtime component may ask for (one page).
+ */
+inline constexpr std::uint32_t MAX_RUNTIME_COMPONENT_ALIGNMENT = 4096;
+
+/**
+ * @brief Why registering a runtime component type failed.
+ */
+enum class DescriptorError : std::uint8_t {
+    None,
+    EmptySize,          ///< size is 0
+    BadAlignment,       ///< alignment is 0, not a power of two, or above MAX_RUNTIME_COMPONENT_ALIGNMENT
+    FieldOutOfBounds,   ///< A field extends past the component's size
+    FieldSizeMismatch,  ///< A typed field's size differs from its type's, or a Bytes field is empty
+    FieldMisaligned,    ///< A typed field is not aligned to its own size within the component
+    DuplicateName,      ///< A runtime component type of that name is already registered
+    TooManyTypes        ///< Every component type ID is taken
+};
+
+/**
+ * @brief Size in bytes of a field type, or 0 for Bytes, whose size is free.
+ */
+[[nodiscard]] constexpr std::uint32_t field_type_size(const FieldType type) noexcept {
+    switch (type) {
+        case FieldType::Bool:
+            return sizeof(bool);
+        case FieldType::Int32:
+        case FieldType::UInt32:
+        case FieldType::Float32:
+            return 4;
+        case FieldType::Int64:
+        case FieldType::UInt64:
+        case FieldType::Float64:
+            return 8;
+        case FieldType::Entity:
+            return sizeof(Entity);
+        case FieldType::Bytes:
+            return 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Checks a descriptor's own layout, e.g. one parsed from mod data.
+ *
+ * A typed field must be aligned to its size within the component, and
+ * the component's alignment must be at least that size, so typed
+ * access through RawComponentView::field() is always aligned.
+ */
+[[nodiscard]] inline DescriptorError validate_descriptor(const ComponentDescriptor& descriptor) noexcept {
+    if (descriptor.size == 0) {
+        return DescriptorError::EmptySize;
+    }
+    if (!std::has_single_bit(descriptor.alignment) || descriptor.alignment > MAX_RUNTIME_COMPONENT_ALIGNMENT) {
+        return DescriptorError::BadAlignment;
+    }
+
+    for (const auto& field : descriptor.fields) {
+        // Widened so a huge offset cannot wrap back inside the component
+        if (std::uint64_t{field.offset} + field.size > descriptor.size) {
+            return DescriptorError::FieldOutOfBounds;
+        }
+
+        const auto type_size = field_type_size(field.type);
+        if (type_size == 0 ? field.size == 0 : field.size != type_size) {
+            return DescriptorError::FieldSizeMismatch;
+        }
+        if (type_size != 0 && (field.offset % type_size != 0 || descriptor.alignment < type_size)) {
+            return DescriptorError::FieldMisaligned;
+        }
+    }
+    return DescriptorError::None;
+}
+
+/**
+ * @brief Raw byte view over a runtime component pool.
+ *
+ * Meant for scripting bindings: resolve a FieldDescriptor once, then
+ * walk the dense pool with pointer arithmetic only. Adding or removing
+ * components of the type invalidates the view.
+ */
+class RawComponentView {
+    std::byte* data_;
+    const Entity* entities_;
+    std::size_t stride_;
+    std::size_t size_;
+
+public:
+    RawComponentView(std::byte* data, const Entity* entities, const std::size_t stride, const std::size_t size) noexcept
+        : data_(data), entities_(entities), stride_(stride), size_(size) {}
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t stride() const noexcept {
+        return stride_;
+    }
+
+    [[nodiscard]] std::byte* data() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] Entity entity_at(const std::size_t index) const noexcept {
+        assert(index < size_ && "Component index out of range");
+        return entities_[index];
+    }
+
+    /**
+     * @brief Start of the component at a dense index.
+     */
+    [[nodiscard]] std::byte* operator[](const std::size_t index) const noexcept {
+        assert(index < size_ && "Component index out of range");
+        return data_ + index * stride_;
+    }
+
+    /**
+     * @brief Typed access to a field of the component at a dense index.
+     * @tparam T A trivially copyable type of exactly the field's size
+     */
+    template<typename T>
+    [[nodiscard]] T& field(const std::size_t index, const FieldDescriptor& field) const noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "Fields are plain bytes");
+        assert(sizeof(T) == field.size && "Field size does not match the requested type");
+        return *std::launder(reinterpret_cast<T*>((*this)[index] + field.offset));
+    }
+};
+
+/**
+ * @brief Dense byte storage for a component type registered at runtime.
+ *
+ * Same layout as ComponentArray — a packed pool with swap-remove — but
+ * the element size and alignment come from a ComponentDescriptor. A
+ * sparse entity-to-index table makes per-entity lookups a single load,
+ * and an occupancy bitset lets World::each_with() intersect runtime
+ * pools with compile-time ones.
+ */
+class RuntimeComponentArray final : public IComponentArray {
+    static constexpr std::uint32_t NO_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    ComponentDescriptor descriptor_;
+    std::size_t storage_alignment_;
+    std::size_t stride_;
+    std::byte* components_;
+    std::vector<Entity> entities_{};
+    std::vector<std::uint32_t> index_of_;
+    EntityMask occupancy_{};
+
+public:
+    explicit RuntimeComponentArray(ComponentDescriptor descriptor)
+        : descriptor_(std::move(descriptor)),
+          storage_alignment_(std::max<std::size_t>(descriptor_.alignment, CACHE_LINE_SIZE)),
+          stride_(0),
+          components_(nullptr),
+          index_of_(MAX_ENTITIES, NO_INDEX) {
+        // World::register_runtime_component() refuses descriptors that fail this
+        assert(validate_descriptor(descriptor_) == DescriptorError::None && "Invalid component descriptor");
+
+        stride_ = (descriptor_.size + descriptor_.alignment - 1) / descriptor_.alignment * descriptor_.alignment;
+        components_ = static_cast<std::byte*>(
+            ::operator new(stride_ * MAX_ENTITIES, std::align_val_t{storage_alignment_}));
+        entities_.reserve(MAX_ENTITIES);
+    }
+
+    RuntimeComponentArray(const RuntimeComponentArray&) = delete;
+    RuntimeComponentArray& operator=(const RuntimeComponentArray&) = delete;
+
+    ~RuntimeComponentArray() override {
+        ::operator delete(components_, std::align_val_t{storage_alignment_});
+    }
+
+    /**
+     * @brief Adds a component to an entity.
+     * @param bytes Initial value of descriptor().size bytes, or nullptr to zero-fill
+     * @return Pointer to the stored component
+     */
+    std::byte* insert(const Entity entity, const void* bytes) noexcept {
+        assert(entity < MAX_ENTITIES && "Entity ID out of range");
+        assert(index_of_[entity] == NO_INDEX && "Component already exists for entity");
+
+        const auto index = static_cast<std::uint32_t>(entities_.size());
+        index_of_[entity] = index;
+        entities_.push_back(entity);
+        occupancy_.set(entity);
+
+        std::byte* component = components_ + index * stride_;
+        if (bytes != nullptr) {
+            std::memcpy(component, bytes, descriptor_.size);
+        } else {
+            std::memset(component, 0, descriptor_.size);
+        }
+        return component;
+    }
+
+    void remove(const Entity entity) noexcept {
+        assert(has(entity) && "Component does not exist for entity");
+
+        const auto index = index_of_[entity];
+        const auto last = static_cast<std::uint32_t>(entities_.size() - 1);
+
+        // Move the last element into the hole to keep the pool dense
+        if (index != last) {
+            std::memcpy(components_ + index * stride_, components_ + last * stride_, descriptor_.size);
+            entities_[index] = entities_[last];
+            index_of_[entities_[index]] = index;
+        }
+
+        entities_.pop_back();
+        index_of_[entity] = NO_INDEX;
+        occupancy_.reset(entity);
+    }
+
+    [[nodiscard]] std::byte* get(const Entity entity) noexcept {
+        assert(has(entity) && "Component does not exist for entity");
+        return components_ + index_of_[entity] * stride_;
+    }
+
+    [[nodiscard]] const std::byte* get(const Entity entity) const noexcept {
+        assert(has(entity) && "Component does not exist for entity");
+        return components_ + index_of_[entity] * stride_;
+    }
+
+    [[nodiscard]] bool has(const Entity entity) const noexcept {
+        return entity < MAX_ENTITIES && index_of_[entity] != NO_INDEX;
+    }
+
+    [[nodiscard]] Entity entity_at(const std::size_t index) const noexcept {
+        assert(index < entities_.size() && "Component index out of range");
+        return entities_[index];
+    }
+
+    [[nodiscard]] RawComponentView view() noexcept {
+        return {components_, entities_.data(), stride_, entities_.size()};
+    }
+
+    [[nodiscard]] const std::byte* data() const noexcept {
+        return components_;
+    }
+
+    [[nodiscard]] std::byte* data() noexcept {
+        return components_;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return entities_.size();
+    }
+
+    /**
+     * @brief Distance in bytes between consecutive components.
+     */
+    [[nodiscard]] std::size_t get_stride() const noexcept {
+        return stride_;
+    }
+
+    [[nodiscard]] const ComponentDescriptor& get_descriptor() const noexcept {
+        return descriptor_;
+    }
+
+    /**
+     * @brief Bit per entity that has a component in this pool.
+     */
+    [[nodiscard]] const EntityMask& occupancy() const noexcept {
+        return occupancy_;
+    }
+
+    /**
+     * @brief Makes this array an exact copy of another with the same layout, copying only live slots.
+     */
+    void copy_from(const RuntimeComponentArray& other) noexcept {
+        assert(stride_ == other.stride_ && descriptor_.size == other.descriptor_.size && "Pools have different layouts");
+        std::memcpy(components_, other.components_, other.entities_.size() * stride_);
+        entities_ = other.entities_;
+        index_of_ = other.index_of_;
+        occupancy_ = other.occupancy_;
+    }
+
+    void entity_destroyed(const Entity entity) override {
+        if (has(entity)) {
+            remove(entity);
+        }
+    }
+};
+
+}
+
+#endif//GAME_ECS_RUNTIME_COMPONENT_HPP
@@ -0,0 +1,111 @@
+#ifndef GAME_ECS_SERIALIZATION_HPP
+#define GAME_ECS_SERIALIZATION_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Appends raw values to a growable byte buffer.
+ *
+ * Values are written in native byte order; the files produced
+ * are meant to be read back by the same build on the same platform.
+ */
+class BinaryWriter {
+    std::vector<std::byte> buffer_{};
+
+public:
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+        write_bytes(&value, sizeof(T));
+    }
+
+    void write_bytes(const void* data, const std::size_t size) {
+        const auto offset = buffer_.size();
+        buffer_.resize(offset + size);
+        std::memcpy(buffer_.data() + offset, data, size);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return buffer_.size();
+    }
+
+    /**
+     * @brief Empties the buffer but keeps its capacity for reuse.
+     */
+    void clear() noexcept {
+        buffer_.clear();
+    }
+
+    [[nodiscard]] const std::vector<std::byte>& bytes() const noexcept {
+        return buffer_;
+    }
+
+    [[nodiscard]] std::vector<std::byte> release() noexcept {
+        return std::move(buffer_);
+    }
+};
+
+/**
+ * @brief Reads raw values back from a byte span.
+ *
+ * Reads past the end leave the destination untouched and put the
+ * reader into a failed state, so callers can check ok() once after
+ * decoding a whole record instead of after every field.
+ */
+class BinaryReader {
+    std::span<const std::byte> bytes_{};
+    std::size_t offset_{0};
+    bool ok_{true};
+
+public:
+    BinaryReader() = default;
+    explicit BinaryReader(const std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+    template<typename T>
+    bool read(T& value) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read");
+        return read_bytes(&value, sizeof(T));
+    }
+
+    bool read_bytes(void* out, const std::size_t size) noexcept {
+        if (!ok_ || remaining() < size) {
+            ok_ = false;
+            return false;
+        }
+        std::memcpy(out, bytes_.data() + offset_, size);
+        offset_ += size;
+        return true;
+    }
+
+    /**
+     * @brief Returns a view of the next bytes without copying them.
+     */
+    [[nodiscard]] std::span<const std::byte> take(const std::size_t size) noexcept {
+        if (!ok_ || remaining() < size) {
+            ok_ = false;
+            return {};
+        }
+        const auto view = bytes_.subspan(offset_, size);
+        offset_ += size;
+        return view;
+    }
+
+    [[nodiscard]] std::size_t remaining() const noexcept {
+        return bytes_.size() - offset_;
+    }
+
+    [[nodiscard]] bool ok() const noexcept {
+        return ok_;
+    }
+};
+
+}
+
+#endif//GAME_ECS_SERIALIZATION_HPP
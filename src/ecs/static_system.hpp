@@ -0,0 +1,147 @@
+#ifndef GAME_ECS_STATIC_SYSTEM_HPP
+#define GAME_ECS_STATIC_SYSTEM_HPP
+
+#include "ecs/access_audit.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_manager.hpp"
+#include "ecs/view.hpp"
+#include "ecs/world.hpp"
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+
+namespace game::ecs {
+
+template<typename Derived, typename ReadsT = Reads<>, typename WritesT = Writes<>>
+class StaticSystem;
+
+/**
+ * @brief System whose component access is fixed at compile time.
+ *
+ * Derive with CRTP and list the components read and written:
+ * @code
+ * class MovementSystem : public StaticSystem<MovementSystem, Reads<Velocity>, Writes<Position>> {
+ * public:
+ *     void update(float delta, Entity entity, Position& position, const Velocity& velocity);
+ * };
+ * @endcode
+ * The signature (every listed type), the declared access and the view
+ * type all follow from the lists. update() receives the written
+ * components by reference and the read ones by const reference, in list
+ * order, and is called for every entity of the view. Unlike System it
+ * is not virtual and keeps no entity set: run in a StaticSystemGroup,
+ * the whole loop is visible to the compiler and can be inlined.
+ *
+ * The view is driven by the first written type, or the first read type
+ * if nothing is written; list the rarest type first.
+ *
+ * While the World has observers, every written type is reported with
+ * World::mark_component_changed() after each update(), so journals and
+ * change checksums see the writes without the system marking them.
+ */
+template<typename Derived, typename... Rs, typename... Ws>
+class StaticSystem<Derived, Reads<Rs...>, Writes<Ws...>> {
+    static_assert(sizeof...(Rs) + sizeof...(Ws) > 0, "A static system must access at least one component");
+
+    // Pools live as long as their world, so the view is built once per world
+    const World* view_world_{nullptr};
+    std::optional<View<Ws..., const Rs...>> view_{};
+
+public:
+    using reads = Reads<Rs...>;
+    using writes = Writes<Ws...>;
+    using view_type = View<Ws..., const Rs...>;
+
+    /**
+     * @brief Components an entity needs to be updated.
+     */
+    [[nodiscard]] static Signature signature(const World& world) noexcept {
+        return world.make_signature<Ws..., Rs...>();
+    }
+
+    [[nodiscard]] static SystemAccess access(const World& world) noexcept {
+        return {world.make_signature<Rs...>(), world.make_signature<Ws...>(), typeid(Derived).name()};
+    }
+
+    /**
+     * @brief Calls Derived::update() for every matching entity.
+     */
+    void run(World& world, const float delta) {
+        auto& self = static_cast<Derived&>(*this);
+#ifdef ECS_ACCESS_AUDIT
+        // Fetch the pools every run so each run's access is audited
+        view_world_ = nullptr;
+#endif
+        if (view_world_ != &world) {
+            view_.emplace(world.view<Ws..., const Rs...>());
+            view_world_ = &world;
+        }
+
+        const auto& view = *view_;
+        if constexpr (sizeof...(Ws) > 0) {
+            if (world.has_observers()) {
+                for (auto it = view.begin(); it != view.end(); ++it) {
+                    std::apply([&](const Entity entity, auto&... components) {
+                        self.update(delta, entity, components...);
+                        (world.template mark_component_changed<Ws>(entity), ...);
+                    }, *it);
+                }
+                return;
+            }
+        }
+
+        for (auto it = view.begin(); it != view.end(); ++it) {
+            std::apply([&](const Entity entity, auto&... components) {
+                self.update(delta, entity, components...);
+            }, *it);
+        }
+    }
+};
+
+/**
+ * @brief Runs a fixed list of static systems, in order, with static dispatch.
+ *
+ * Holds the systems by value and calls each run() directly, so there is
+ * no virtual call or set walk per system. Tick it next to World::tick().
+ * In ECS_ACCESS_AUDIT builds each system is audited against its
+ * compile-time access.
+ */
+template<typename... Systems>
+class StaticSystemGroup {
+    std::tuple<Systems...> systems_;
+
+public:
+    explicit StaticSystemGroup(Systems... systems) : systems_(std::move(systems)...) {}
+
+    template<typename S>
+    [[nodiscard]] S& get() noexcept {
+        return std::get<S>(systems_);
+    }
+
+    void tick(World& world, const float delta) {
+        std::apply([&](auto&... systems) { (run_one(systems, world, delta), ...); }, systems_);
+    }
+
+private:
+    template<typename S>
+    static void run_one(S& system, World& world, const float delta) {
+#ifdef ECS_ACCESS_AUDIT
+        const SystemAccess access = S::access(world);
+        const SystemAccess* stage[] = {&access};
+        AccessAudit::begin_stage(stage);
+        {
+            AccessAudit::SystemScope scope(access);
+            system.run(world, delta);
+        }
+        AccessAudit::end_stage();
+#else
+        system.run(world, delta);
+#endif
+    }
+};
+
+}
+
+#endif//GAME_ECS_STATIC_SYSTEM_HPP
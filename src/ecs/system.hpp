@@ -1,7 +1,9 @@
 #ifndef GAME_ECS_SYSTEM_HPP
 #define GAME_ECS_SYSTEM_HPP
 
+#include "cache.hpp"
 #include "entity.hpp"
+#include "entity_bitset.hpp"
 #include <set>
 
 namespace game::ecs {
@@ -12,13 +14,30 @@ namespace game::ecs {
  * Systems contain the logic that operates on entities with
  * specific component combinations. They are notified when
  * entities are added or removed from their interest set.
+ *
+ * Systems are line-aligned so the state of systems ticking in
+ * parallel never shares a cache line.
+ *
+ * Systems that remove entities while iterating, e.g. an attacker
+ * destroyed on hit, should use for_each_enabled(): removing from
+ * entities_ invalidates iterators into it.
  */
-struct System {
+struct alignas(CACHE_LINE_SIZE) System {
     /**
      * @brief Set of entities that match this system's signature.
      */
     std::set<Entity> entities_;
 
+    /**
+     * @brief entities_ as a bitset, kept in step by SystemManager.
+     */
+    EntityMask members_{};
+
+    /**
+     * @brief Enabled entities of the world, set on registration.
+     */
+    const EntityMask* enabled_mask_{nullptr};
+
     virtual ~System() = default;
 
     /**
@@ -26,6 +45,30 @@ struct System {
      * @param delta Time elapsed since last frame
      */
     virtual void tick(float delta) = 0;
+
+    /**
+     * @brief Called after an entity left entities_, because it was destroyed or its signature changed.
+     *
+     * Lets systems drop per-entity state before the ID can be recycled.
+     */
+    virtual void entity_removed(Entity /*entity*/) {}
+
+    /**
+     * @brief Calls f(entity) for every entity of entities_ that is enabled, in ID order.
+     *
+     * Walks the membership and enabled bitsets a word at a time, so
+     * disabled stretches cost nothing per entity. f may remove or
+     * disable any entity, including ones not yet visited: those are
+     * skipped, since the bitsets are re-read after every call.
+     */
+    template<typename F>
+    void for_each_enabled(F&& f) const {
+        if (enabled_mask_ == nullptr) {
+            members_.for_each(f);
+        } else {
+            members_.for_each_intersection(f, *enabled_mask_);
+        }
+    }
 };
 
 }
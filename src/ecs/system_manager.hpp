@@ -1,14 +1,21 @@
 #ifndef GAME_ECS_SYSTEM_MANAGER_HPP
 #define GAME_ECS_SYSTEM_MANAGER_HPP
 
+#include "ecs/access_audit.hpp"
 #include "ecs/entity.hpp"
 #include "ecs/entity_manager.hpp"
+#include "ecs/query.hpp"
 #include "ecs/system.hpp"
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 namespace game::ecs {
 
@@ -18,50 +25,117 @@ namespace game::ecs {
  * Handles system registration, signature management, and
  * entity-system relationship updates. Maintains the list
  * of entities that each system should operate on.
+ *
+ * Membership updates go through an inverted index from component type
+ * to the systems requiring or excluding it, so a signature change only
+ * visits the systems that name one of the changed components, and only
+ * touches the entity sets of systems the entity joins or leaves. Set a
+ * system's signature before entities that match it get components.
+ * A system whose signature was never set, e.g. one that only consumes
+ * events, tracks no entities.
  */
  class SystemManager {
-    std::unordered_map<std::type_index, Signature> signatures_;
+    struct IndexedSystem {
+        System* system;
+        SignatureFilter filter;
+    };
+
+    std::unordered_map<std::type_index, SignatureFilter> filters_;
     std::unordered_map<std::type_index, std::unique_ptr<System>> systems_;
+    std::unordered_map<std::type_index, SystemAccess> accesses_;
+
+    // Rebuilt whenever systems or signatures change
+    std::vector<IndexedSystem> indexed_;
+    std::array<std::vector<std::uint32_t>, MAX_COMPONENT_TYPES> systems_by_component_;
+    // Systems requiring nothing, checked on every change
+    std::vector<std::uint32_t> unindexed_;
+    std::vector<std::uint64_t> visited_;
+    std::uint64_t visit_stamp_{0};
 
 public:
     /**
      * @brief Called once per-frame.
+     *
+     * Systems run one after another, so each forms its own stage; in
+     * ECS_ACCESS_AUDIT builds systems with declared access are audited.
+     *
      * @param delta Time elapsed since last frame
      */
     void tick(const float delta) noexcept {
-        for (const auto &system: systems_ | std::views::values) {
+        for (auto& [index, system] : systems_) {
+#ifdef ECS_ACCESS_AUDIT
+            if (const auto it = accesses_.find(index); it != accesses_.end()) {
+                const SystemAccess* stage[] = {&it->second};
+                AccessAudit::begin_stage(stage);
+                {
+                    AccessAudit::SystemScope scope(it->second);
+                    system->tick(delta);
+                }
+                AccessAudit::end_stage();
+                continue;
+            }
+#endif
             system->tick(delta);
         }
     }
 
     /**
      * @brief Called when an entity's signature changes.
-     * Updates all systems' entity lists accordingly
-     * 
+     * Adds the entity to systems it now matches and removes it from
+     * systems it no longer matches.
+     *
      * @param entity The entity whose signature changed
-     * @param entity_signature The entity's new signature
+     * @param old_signature The entity's previous signature
+     * @param new_signature The entity's new signature
      */
-    void entity_signature_changed(const Entity entity, const Signature entity_signature) noexcept {
-        for (auto& [index, system] : systems_) {
-            if (const auto& system_signature = signatures_[index]; (entity_signature & system_signature) == system_signature) {
-                // Entity signature matches system signature (add to set)
-                system->entities_.insert(entity);
+    void entity_signature_changed(const Entity entity, const Signature& old_signature, const Signature& new_signature) noexcept {
+        ++visit_stamp_;
+        for_each_bit(old_signature ^ new_signature, [&](const std::size_t type) {
+            for (const auto id : systems_by_component_[type]) {
+                if (visited_[id] == visit_stamp_) {
+                    continue;
+                }
+                visited_[id] = visit_stamp_;
+
+                const auto& [system, filter] = indexed_[id];
+                const bool matched = filter.matches(old_signature);
+                if (const bool matches = filter.matches(new_signature); matches && !matched) {
+                    add_member(*system, entity);
+                } else if (!matches && matched) {
+                    remove_member(*system, entity);
+                }
+            }
+        });
+
+        for (const auto id : unindexed_) {
+            const auto& [system, filter] = indexed_[id];
+            if (filter.matches(new_signature)) {
+                add_member(*system, entity);
             } else {
-                // Entity signature does not match system signature (remove from set)
-                system->entities_.erase(entity);
+                remove_member(*system, entity);
             }
         }
     }
 
     /**
      * @brief Called when an entity is destroyed.
-     * Removes the entity from all systems.
+     * Removes the entity from every system it may belong to.
      *
      * @param entity The entity that was destroyed
+     * @param signature The entity's signature before it was destroyed
      */
-    void entity_destroyed(const Entity entity) noexcept {
-        for (const auto &system: systems_ | std::views::values) {
-            system->entities_.erase(entity);
+    void entity_destroyed(const Entity entity, const Signature& signature) noexcept {
+        ++visit_stamp_;
+        for_each_bit(signature, [&](const std::size_t type) {
+            for (const auto id : systems_by_component_[type]) {
+                if (visited_[id] != visit_stamp_) {
+                    visited_[id] = visit_stamp_;
+                    remove_member(*indexed_[id].system, entity);
+                }
+            }
+        });
+        for (const auto id : unindexed_) {
+            remove_member(*indexed_[id].system, entity);
         }
     }
 
@@ -76,6 +150,7 @@ public:
         auto& system_ref = *system;
 
         systems_.emplace(index, std::move(system));
+        rebuild_index();
 
         return system_ref;
     }
@@ -88,7 +163,9 @@ public:
         assert(systems_.contains(index) && "System is not registered");
 
         systems_.erase(index);
-        signatures_.erase(index);
+        filters_.erase(index);
+        accesses_.erase(index);
+        rebuild_index();
     }
 
     template<typename T>
@@ -135,12 +212,99 @@ public:
 
     template<typename T>
     void set_signature(const Signature signature) noexcept {
+        set_filter<T>({signature});
+    }
+
+    template<typename T>
+    void set_filter(const SignatureFilter& filter) noexcept {
         static_assert(std::is_base_of_v<System, T>, "T must inherit System");
+        assert((filter.include & filter.exclude).none() && "Component is both required and excluded");
 
         const auto index = std::type_index(typeid(T));
         assert(systems_.contains(index) && "System is not registered");
 
-        signatures_[index] = signature;
+        filters_[index] = filter;
+        rebuild_index();
+    }
+
+    /**
+     * @brief Gets the signature filter of a system.
+     * @return The filter, or nullptr if the system has none
+     */
+    template<typename T>
+    [[nodiscard]] const SignatureFilter* find_filter() const noexcept {
+        const auto it = filters_.find(std::type_index(typeid(T)));
+        return it != filters_.end() ? &it->second : nullptr;
+    }
+
+    template<typename T>
+    void set_access(const SystemAccess access) noexcept {
+        static_assert(std::is_base_of_v<System, T>, "T must inherit System");
+
+        const auto index = std::type_index(typeid(T));
+        assert(systems_.contains(index) && "System is not registered");
+
+        accesses_[index] = access;
+    }
+
+    /**
+     * @brief Gets the declared component access of a system.
+     * @return The declaration, or nullptr if the system declared none
+     */
+    template<typename T>
+    [[nodiscard]] const SystemAccess* find_access() const noexcept {
+        static_assert(std::is_base_of_v<System, T>, "T must inherit System");
+
+        const auto it = accesses_.find(std::type_index(typeid(T)));
+        return (it != accesses_.end()) ? &it->second : nullptr;
+    }
+
+private:
+    template<typename F>
+    static void for_each_bit(const Signature& signature, F&& f) {
+        for (auto bits = signature.to_ullong(); bits != 0; bits &= bits - 1) {
+            f(static_cast<std::size_t>(std::countr_zero(bits)));
+        }
+    }
+
+    static void add_member(System& system, const Entity entity) {
+        system.entities_.insert(entity);
+        system.members_.set(entity);
+    }
+
+    static void remove_member(System& system, const Entity entity) noexcept {
+        if (system.members_.test(entity)) {
+            system.entities_.erase(entity);
+            system.members_.reset(entity);
+            system.entity_removed(entity);
+        }
+    }
+
+    void rebuild_index() {
+        indexed_.clear();
+        unindexed_.clear();
+        for (auto& systems : systems_by_component_) {
+            systems.clear();
+        }
+
+        for (const auto& [index, system] : systems_) {
+            const auto it = filters_.find(index);
+            if (it == filters_.end()) {
+                continue;
+            }
+            const auto& filter = it->second;
+            const auto id = static_cast<std::uint32_t>(indexed_.size());
+            indexed_.push_back({system.get(), filter});
+
+            if (filter.include.none()) {
+                unindexed_.push_back(id);
+                continue;
+            }
+            for_each_bit(filter.include | filter.exclude, [&](const std::size_t type) {
+                systems_by_component_[type].push_back(id);
+            });
+        }
+        visited_.assign(indexed_.size(), 0);
     }
  };
 
@@ -0,0 +1,283 @@
+#ifndef GAME_ECS_VIEW_HPP
+#define GAME_ECS_VIEW_HPP
+
+#include "ecs/component_array.hpp"
+#include "ecs/component_storage.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_bitset.hpp"
+#include "ecs/query.hpp"
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace game::ecs {
+
+/**
+ * @brief Default number of entities a View prefetches ahead; 0 disables prefetching.
+ *
+ * view_bench measured no distance faster than no prefetching on a
+ * 3-component join larger than the LLC, and larger distances slower,
+ * so views do not prefetch unless set_prefetch_distance() is called
+ * with a distance view_bench found to pay off on the target machine.
+ */
+constexpr std::size_t DEFAULT_VIEW_PREFETCH_DISTANCE = 0;
+
+namespace detail {
+
+template<typename T>
+using ViewPool = std::conditional_t<std::is_const_v<T>, const PublishedStorage<std::remove_const_t<T>>, ComponentStorage<T>>;
+
+/**
+ * @brief Secondary term of a View: a component every visited entity has.
+ */
+template<typename T>
+struct ViewTerm {
+    using value_type = std::tuple<T&>;
+
+    ViewPool<T>* pool;
+
+    ViewTerm(ViewPool<T>& pool) noexcept : pool(&pool) {}
+
+    [[nodiscard]] bool admits(const Entity entity) const noexcept {
+        return pool->has(entity);
+    }
+
+    void prefetch_index(const Entity entity) const noexcept {
+        pool->prefetch_index(entity);
+    }
+
+    void prefetch(const Entity entity) const noexcept {
+        pool->prefetch_slot(entity);
+    }
+
+    [[nodiscard]] value_type fetch(const Entity entity) const noexcept {
+        return {pool->get(entity)};
+    }
+};
+
+/**
+ * @brief Components no visited entity has; yields nothing.
+ */
+template<typename... Ts>
+struct ViewTerm<Without<Ts...>> {
+    using value_type = std::tuple<>;
+
+    std::tuple<ViewPool<const Ts>*...> pools;
+
+    explicit ViewTerm(ViewPool<const Ts>&... pools) noexcept : pools(&pools...) {}
+
+    [[nodiscard]] bool admits(const Entity entity) const noexcept {
+        return !(std::get<ViewPool<const Ts>*>(pools)->has(entity) || ...);
+    }
+
+    void prefetch_index(const Entity entity) const noexcept {
+        (std::get<ViewPool<const Ts>*>(pools)->prefetch_index(entity), ...);
+    }
+
+    void prefetch(Entity) const noexcept {}
+
+    [[nodiscard]] value_type fetch(Entity) const noexcept {
+        return {};
+    }
+};
+
+/**
+ * @brief Components visited entities may have; yields a pointer per type, null when absent.
+ */
+template<typename... Ts>
+struct ViewTerm<Optional<Ts...>> {
+    using value_type = std::tuple<Ts*...>;
+
+    std::tuple<ViewPool<Ts>*...> pools;
+
+    explicit ViewTerm(ViewPool<Ts>&... pools) noexcept : pools(&pools...) {}
+
+    [[nodiscard]] bool admits(Entity) const noexcept {
+        return true;
+    }
+
+    void prefetch_index(const Entity entity) const noexcept {
+        (std::get<ViewPool<Ts>*>(pools)->prefetch_index(entity), ...);
+    }
+
+    void prefetch(const Entity entity) const noexcept {
+        (std::get<ViewPool<Ts>*>(pools)->prefetch_slot(entity), ...);
+    }
+
+    [[nodiscard]] value_type fetch(const Entity entity) const noexcept {
+        return {get<Ts>(entity)...};
+    }
+
+private:
+    template<typename T>
+    [[nodiscard]] T* get(const Entity entity) const noexcept {
+        auto* pool = std::get<ViewPool<T>*>(pools);
+        return pool->has(entity) ? &pool->get(entity) : nullptr;
+    }
+};
+
+}
+
+/**
+ * @brief Join over the pools of several component types.
+ *
+ * Walks the dense array of the first (primary) type in order and looks
+ * the other (secondary) types up through their sparse index, skipping
+ * entities that lack any of them. Secondary slots are reached in random
+ * order, so prefetching runs in two stages: while visiting the entity
+ * at dense index i the iterator prefetches the sparse index entries of
+ * the entity at i + 2 * distance, then the secondary components of the
+ * entity at i + distance, whose entries have arrived by then.
+ * Put the type with the fewest components first.
+ *
+ * Adding or removing components of the viewed types invalidates the view.
+ * A const-qualified type (View<const Position>) reads a const pool and
+ * yields const references; for double-buffered types pass the published
+ * front buffer.
+ *
+ * Secondary terms may also be Without<Ts...>, skipping entities that
+ * have any of Ts, and Optional<Ts...>, yielding a Ts* per type that is
+ * null when the entity lacks it:
+ * @code
+ * for (auto [entity, position, sprite] : world.view<Position, Without<Hidden>, Optional<Sprite>>()) {
+ *     if (sprite) { ... }
+ * }
+ * @endcode
+ * Both are answered from the pools' sparse indices, like required types.
+ *
+ * With an enabled mask set, entities whose bit is clear are skipped.
+ */
+template<typename Primary, typename... Secondary>
+class View {
+    template<typename T>
+    using Pool = detail::ViewPool<T>;
+
+    template<typename T>
+    using Term = detail::ViewTerm<T>;
+
+    Pool<Primary>* primary_;
+    std::tuple<Term<Secondary>...> secondary_;
+    std::size_t prefetch_distance_;
+    const EntityMask* enabled_{nullptr};
+
+public:
+    class iterator {
+        const View* view_;
+        std::size_t index_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = decltype(std::tuple_cat(std::declval<std::tuple<Entity, Primary&>>(),
+                                                   std::declval<typename Term<Secondary>::value_type>()...));
+        using reference = value_type;
+
+        iterator(const View* view, const std::size_t index) noexcept : view_(view), index_(index) {
+            skip_unmatched();
+        }
+
+        reference operator*() const noexcept {
+            const auto entity = view_->primary_->entity_at(index_);
+            return std::tuple_cat(std::tuple<Entity, Primary&>(entity, view_->primary_->at(index_)),
+                                  std::get<Term<Secondary>>(view_->secondary_).fetch(entity)...);
+        }
+
+        iterator& operator++() noexcept {
+            ++index_;
+            skip_unmatched();
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+
+    private:
+        void skip_unmatched() noexcept {
+            const auto size = view_->primary_->size();
+            while (index_ < size) {
+                view_->prefetch_ahead(index_);
+                if (view_->matches(view_->primary_->entity_at(index_))) {
+                    return;
+                }
+                ++index_;
+            }
+        }
+    };
+
+    explicit View(Pool<Primary>& primary, Term<Secondary>... secondary,
+                  const std::size_t prefetch_distance = DEFAULT_VIEW_PREFETCH_DISTANCE) noexcept
+        : primary_(&primary), secondary_(secondary...), prefetch_distance_(prefetch_distance) {}
+
+    [[nodiscard]] iterator begin() const noexcept {
+        return iterator(this, 0);
+    }
+
+    [[nodiscard]] iterator end() const noexcept {
+        return iterator(this, primary_->size());
+    }
+
+    /**
+     * @brief Calls f(entity, primary, secondary...) for every entity in the join.
+     */
+    template<typename F>
+    void each(F&& f) const {
+        for (auto it = begin(); it != end(); ++it) {
+            std::apply(f, *it);
+        }
+    }
+
+    /**
+     * @brief Sets how many entities ahead secondary components are prefetched.
+     * @param distance Look-ahead in entities; 0 disables prefetching
+     */
+    void set_prefetch_distance(const std::size_t distance) noexcept {
+        prefetch_distance_ = distance;
+    }
+
+    [[nodiscard]] std::size_t get_prefetch_distance() const noexcept {
+        return prefetch_distance_;
+    }
+
+    /**
+     * @brief Skips entities whose bit in the mask is clear.
+     * @param enabled Mask of visited entities; nullptr visits all
+     */
+    void set_enabled_mask(const EntityMask* enabled) noexcept {
+        enabled_ = enabled;
+    }
+
+private:
+    [[nodiscard]] bool matches(const Entity entity) const noexcept {
+        return (enabled_ == nullptr || enabled_->test(entity)) && (std::get<Term<Secondary>>(secondary_).admits(entity) && ...);
+    }
+
+    void prefetch_ahead(const std::size_t index) const noexcept {
+        if constexpr (sizeof...(Secondary) > 0) {
+            if (prefetch_distance_ == 0) {
+                return;
+            }
+            // Slots are found through the sparse index, so its entries are fetched a stage earlier
+            if (const auto far = index + 2 * prefetch_distance_; far < primary_->size()) {
+                const auto entity = primary_->entity_at(far);
+                (std::get<Term<Secondary>>(secondary_).prefetch_index(entity), ...);
+            }
+            if (const auto ahead = index + prefetch_distance_; ahead < primary_->size()) {
+                const auto entity = primary_->entity_at(ahead);
+                (std::get<Term<Secondary>>(secondary_).prefetch(entity), ...);
+            }
+        }
+    }
+};
+
+}
+
+#endif//GAME_ECS_VIEW_HPP
@@ -4,7 +4,22 @@
 #include "ecs/component_manager.hpp"
 #include "ecs/entity.hpp"
 #include "ecs/entity_manager.hpp"
+#include "ecs/event_bus.hpp"
+#include "ecs/query.hpp"
 #include "ecs/system_manager.hpp"
+#include "ecs/view.hpp"
+#include "ecs/world_observer.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace game::ecs {
 
@@ -19,14 +34,36 @@ class World {
     ComponentManager component_manager_;
     EntityManager entity_manager_;
     SystemManager system_manager_;
+    EventBus event_bus_;
+    std::vector<IWorldObserver*> observers_;
 
 public:
     /**
      * @brief Called once per-frame.
+     *
+     * Events emitted during this frame become readable once all
+     * systems have run, so consumers see them next frame. Likewise
+     * writes to double-buffered pools are published at the end, and
+     * cold pools compress the pages that went untouched.
+     *
      * @param delta Time elapsed since last frame
      */
     void tick(const float delta) noexcept {
         system_manager_.tick(delta);
+        event_bus_.swap_buffers();
+        component_manager_.publish_double_buffered();
+        component_manager_.compress_idle();
+    }
+
+    /**
+     * @brief Publishes writes to double-buffered pools now, instead of at the end of tick().
+     *
+     * Needed after setup code writes components outside tick().
+     *
+     * @return Number of pages copied
+     */
+    std::size_t publish_double_buffered() noexcept {
+        return component_manager_.publish_double_buffered();
     }
 
     /**
@@ -34,7 +71,11 @@ public:
      * @return The new entity ID
      */
     Entity add_entity() noexcept {
-        return entity_manager_.add_entity();
+        const Entity entity = entity_manager_.add_entity();
+        for (auto* observer : observers_) {
+            observer->entity_created(entity);
+        }
+        return entity;
     }
 
     /**
@@ -42,9 +83,89 @@ public:
      * @param entity The entity to remove
      */
     void remove_entity(const Entity entity) noexcept {
+        for (auto* observer : observers_) {
+            observer->entity_destroyed(entity, entity_manager_.get_signature(entity));
+        }
+
+        const auto signature = entity_manager_.get_signature(entity);
         entity_manager_.remove_entity(entity);
         component_manager_.entity_destroyed(entity);
-        system_manager_.entity_destroyed(entity);
+        system_manager_.entity_destroyed(entity, signature);
+    }
+
+    /**
+     * @brief Enables or disables an entity.
+     *
+     * Disabled entities keep their components and system membership but
+     * are skipped by views, static systems and System::for_each_enabled().
+     * Costs one bit flip: no pool or system set changes. Entities start
+     * enabled.
+     *
+     * @param entity A living entity
+     * @param enabled Whether the entity is visited
+     */
+    void set_entity_enabled(const Entity entity, const bool enabled) noexcept {
+        assert(entity_manager_.is_alive(entity) && "Can only enable or disable a living entity");
+        entity_manager_.set_enabled(entity, enabled);
+    }
+
+    /**
+     * @brief Whether the ID is in range and currently handed out.
+     */
+    [[nodiscard]] bool is_entity_alive(const Entity entity) const noexcept {
+        return entity_manager_.is_alive(entity);
+    }
+
+    [[nodiscard]] bool is_entity_enabled(const Entity entity) const noexcept {
+        return entity_manager_.is_enabled(entity);
+    }
+
+    /**
+     * @brief Bits of the living, enabled entities; for_each() walks them in ID order.
+     */
+    [[nodiscard]] const EntityMask& get_enabled_mask() const noexcept {
+        return entity_manager_.get_enabled_mask();
+    }
+
+    /**
+     * @brief Subscribes an observer to structural changes.
+     * @param observer Observer to notify; must outlive its subscription
+     */
+    void add_observer(IWorldObserver* observer) {
+        assert(std::find(observers_.begin(), observers_.end(), observer) == observers_.end() && "Observer already added");
+        observers_.push_back(observer);
+    }
+
+    /**
+     * @brief Unsubscribes an observer.
+     * @param observer Observer previously passed to add_observer()
+     */
+    void remove_observer(IWorldObserver* observer) {
+        std::erase(observers_, observer);
+    }
+
+    [[nodiscard]] bool has_observers() const noexcept {
+        return !observers_.empty();
+    }
+
+    /**
+     * @brief Copies the entity recycling queue in hand-out order.
+     * @return IDs that are currently free
+     */
+    [[nodiscard]] std::vector<Entity> get_available_entities() const {
+        return entity_manager_.get_available_entities();
+    }
+
+    /**
+     * @brief Restores the entity recycling queue of a saved world.
+     *
+     * Must be called on an empty world before its components are
+     * restored; every ID not listed becomes alive.
+     *
+     * @param available IDs that are free, in hand-out order
+     */
+    void restore_available_entities(const std::span<const Entity> available) noexcept {
+        entity_manager_.restore_available_entities(available);
     }
 
     /**
@@ -66,11 +187,12 @@ public:
     void add_component(const Entity entity, T component) noexcept {
         component_manager_.add_component<T>(entity, std::move(component));
 
-        auto signature = entity_manager_.get_signature(entity);
-        signature.set(component_manager_.get_component_type<T>(), true);
+        const auto type = component_manager_.get_component_type<T>();
+        set_signature_bit(entity, type, true);
 
-        entity_manager_.set_signature(entity, signature);
-        system_manager_.entity_signature_changed(entity, signature);
+        for (auto* observer : observers_) {
+            observer->component_added(entity, type, &component_manager_.get_component<T>(entity));
+        }
     }
 
     /**
@@ -82,11 +204,12 @@ public:
     void remove_component(const Entity entity) noexcept {
         component_manager_.remove_component<T>(entity);
 
-        auto signature = entity_manager_.get_signature(entity);
-        signature.set(component_manager_.get_component_type<T>(), false);
+        const auto type = component_manager_.get_component_type<T>();
+        set_signature_bit(entity, type, false);
 
-        entity_manager_.set_signature(entity, signature);
-        system_manager_.entity_signature_changed(entity, signature);
+        for (auto* observer : observers_) {
+            observer->component_removed(entity, type);
+        }
     }
 
     /**
@@ -111,6 +234,58 @@ public:
         return component_manager_.get_component<T>(entity);
     }
 
+    /**
+     * @brief Copies several components of a batch of entities at once.
+     *
+     * Each pool is read with ComponentArray::gather(), which prefetches
+     * ahead of the current entity. Use this instead of a get_component()
+     * loop when following lists of references such as targets or contacts.
+     *
+     * @tparam Ts The component types; every entity must have all of them
+     * @param entities The entities to read
+     * @return One vector per component type, in entity order
+     */
+    template<typename... Ts>
+    [[nodiscard]] std::tuple<std::vector<Ts>...> get_many(const std::span<const Entity> entities) const {
+        std::tuple<std::vector<Ts>...> components{std::vector<Ts>(entities.size())...};
+        get_many<Ts...>(entities, std::span<Ts>(std::get<std::vector<Ts>>(components))...);
+        return components;
+    }
+
+    /**
+     * @brief Copies several components of a batch of entities into caller buffers.
+     *
+     * Same as get_many(entities) without allocating, for per-frame use
+     * with reused scratch buffers.
+     */
+    template<typename... Ts>
+    void get_many(const std::span<const Entity> entities, const std::span<Ts>... out) const noexcept {
+        (component_manager_.get_component_array<Ts>()->gather(entities, out), ...);
+    }
+
+    /**
+     * @brief Reports an in-place write to a component.
+     *
+     * Mutable get_component() access is not tracked, so systems that
+     * write components call this afterwards when observers such as
+     * journals need to see the new value.
+     *
+     * @tparam T The component type
+     * @param entity The entity whose component was written
+     */
+    template<typename T>
+    void mark_component_changed(const Entity entity) noexcept {
+        if (observers_.empty()) {
+            return;
+        }
+
+        const auto type = component_manager_.get_component_type<T>();
+        const auto& component = component_manager_.get_component<T>(entity);
+        for (auto* observer : observers_) {
+            observer->component_changed(entity, type, &component);
+        }
+    }
+
     /**
      * @brief Checks if an entity has a component.
      * @tparam T The component type
@@ -122,14 +297,264 @@ public:
         return component_manager_.has_component<T>(entity);
     }
 
+    /**
+     * @brief Gets the dense storage for a component type.
+     *
+     * Useful for tools that need to walk every instance of a
+     * component rather than look them up per entity.
+     *
+     * @tparam T The component type
+     * @return Reference to the component array
+     */
+    template<typename T>
+    [[nodiscard]] ComponentStorage<T>& get_component_array() noexcept {
+        return *component_manager_.get_component_array<T>();
+    }
+
+    /**
+     * @brief Gets the dense storage for a component type (const version).
+     * @tparam T The component type
+     * @return Const reference to the component array
+     */
+    template<typename T>
+    [[nodiscard]] const ComponentStorage<T>& get_component_array() const noexcept {
+        return *component_manager_.get_component_array<T>();
+    }
+
+    /**
+     * @brief Creates a join over the pools of several component types.
+     *
+     * The first type drives iteration; list the rarest one first.
+     * Const-qualified types are only read, from the published buffer
+     * of double-buffered pools. Later terms may be Without<...> and
+     * Optional<...>; see View.
+     *
+     * @tparam Primary The component type driving iteration
+     * @tparam Terms The other component types or terms
+     * @return A view over the enabled entities having all required types
+     */
+    template<typename Primary, typename... Terms>
+    [[nodiscard]] View<Primary, Terms...> view() noexcept {
+        View<Primary, Terms...> view(view_pool<Primary>(), view_term(std::type_identity<Terms>{})...);
+        view.set_enabled_mask(&entity_manager_.get_enabled_mask());
+        return view;
+    }
+
+    /**
+     * @brief Gets the component type ID used for signature bits.
+     * @tparam T The component type
+     * @return The sequential component type ID
+     */
+    template<typename T>
+    [[nodiscard]] ComponentType get_component_type() const noexcept {
+        return component_manager_.get_component_type<T>();
+    }
+
+    /**
+     * @brief Gets the signature of an entity.
+     * @param entity The entity to inspect
+     * @return Bitset of the component types the entity has
+     */
+    [[nodiscard]] const Signature& get_signature(const Entity entity) const noexcept {
+        return entity_manager_.get_signature(entity);
+    }
+
+    /**
+     * @brief Registers a component type defined at runtime, e.g. from a mod schema.
+     *
+     * Runtime components get a regular component type ID, so they take
+     * part in signatures and system queries like compile-time ones.
+     *
+     * The descriptor is validated first, since it typically comes from
+     * mod or JSON data: a zero size, a bad alignment, fields outside the
+     * component or of the wrong size, a taken name or a full type table
+     * register nothing and report why.
+     *
+     * @param descriptor Name, size, alignment and fields of the component
+     * @return The component type ID, or the DescriptorError that refused it
+     */
+    [[nodiscard]] RuntimeRegistration register_runtime_component(ComponentDescriptor descriptor) {
+        return component_manager_.register_runtime_component(std::move(descriptor));
+    }
+
+    /**
+     * @brief Looks up the ID of a runtime component type by name.
+     * @return The type ID, or nullopt if no runtime type has that name, e.g. a mod was not loaded
+     */
+    [[nodiscard]] std::optional<ComponentType> find_runtime_component_type(const std::string& name) const noexcept {
+        return component_manager_.find_runtime_component_type(name);
+    }
+
+    /**
+     * @brief Adds a runtime component to an entity.
+     * @param entity The entity to add the component to
+     * @param type The runtime component type
+     * @param bytes Initial value, or nullptr to zero-fill
+     * @return Pointer to the stored component bytes
+     */
+    std::byte* add_runtime_component(const Entity entity, const ComponentType type, const void* bytes = nullptr) noexcept {
+        std::byte* component = component_manager_.get_runtime_component_array(type)->insert(entity, bytes);
+        set_signature_bit(entity, type, true);
+
+        for (auto* observer : observers_) {
+            observer->component_added(entity, type, component);
+        }
+        return component;
+    }
+
+    /**
+     * @brief Removes a runtime component from an entity.
+     */
+    void remove_runtime_component(const Entity entity, const ComponentType type) noexcept {
+        component_manager_.get_runtime_component_array(type)->remove(entity);
+        set_signature_bit(entity, type, false);
+
+        for (auto* observer : observers_) {
+            observer->component_removed(entity, type);
+        }
+    }
+
+    /**
+     * @brief Gets the bytes of a runtime component of an entity.
+     */
+    [[nodiscard]] std::byte* get_runtime_component(const Entity entity, const ComponentType type) noexcept {
+        return component_manager_.get_runtime_component_array(type)->get(entity);
+    }
+
+    /**
+     * @brief Gets the bytes of a runtime component of an entity (const version).
+     */
+    [[nodiscard]] const std::byte* get_runtime_component(const Entity entity, const ComponentType type) const noexcept {
+        return component_manager_.get_runtime_component_array(type)->get(entity);
+    }
+
+    [[nodiscard]] bool has_runtime_component(const Entity entity, const ComponentType type) const noexcept {
+        return component_manager_.get_runtime_component_array(type)->has(entity);
+    }
+
+    /**
+     * @brief Reports an in-place write to a runtime component.
+     * @see mark_component_changed()
+     */
+    void mark_runtime_component_changed(const Entity entity, const ComponentType type) noexcept {
+        if (observers_.empty()) {
+            return;
+        }
+
+        const auto* component = component_manager_.get_runtime_component_array(type)->get(entity);
+        for (auto* observer : observers_) {
+            observer->component_changed(entity, type, component);
+        }
+    }
+
+    /**
+     * @brief Gets the dense storage of a runtime component type.
+     */
+    [[nodiscard]] RuntimeComponentArray& get_runtime_component_array(const ComponentType type) noexcept {
+        return *component_manager_.get_runtime_component_array(type);
+    }
+
+    /**
+     * @brief Gets the dense storage of a runtime component type (const version).
+     */
+    [[nodiscard]] const RuntimeComponentArray& get_runtime_component_array(const ComponentType type) const noexcept {
+        return *component_manager_.get_runtime_component_array(type);
+    }
+
+    /**
+     * @brief Registers an event type with the ECS.
+     * @tparam T The event type to register
+     * @param initial_capacity Events per frame before the queue has to grow
+     */
+    template<typename T>
+    void register_event(const std::size_t initial_capacity = 1024) {
+        event_bus_.register_event<T>(initial_capacity);
+    }
+
+    /**
+     * @brief Gets the queue for an event type.
+     *
+     * Use emit() to queue events for next frame and read() to
+     * consume the events emitted during the previous frame.
+     *
+     * @tparam T The event type
+     * @return Reference to the event queue
+     */
+    template<typename T>
+    [[nodiscard]] EventQueue<T>& events() noexcept {
+        return event_bus_.get_queue<T>();
+    }
+
+    /**
+     * @brief Gets the queue for an event type (const version).
+     * @tparam T The event type
+     * @return Const reference to the event queue
+     */
+    template<typename T>
+    [[nodiscard]] const EventQueue<T>& events() const noexcept {
+        return event_bus_.get_queue<T>();
+    }
+
     /**
      * @brief Registers a system with the ECS.
+     *
+     * The system tracks no entities until its signature is set.
+     *
      * @tparam T The system type to register
      * @return Reference to the registered system
      */
     template<typename T, typename... Args>
     [[nodiscard]] T& register_system(Args&&... args) noexcept {
-        return system_manager_.register_system<T>(std::forward<Args>(args)...);
+        auto& system = system_manager_.register_system<T>(std::forward<Args>(args)...);
+        system.enabled_mask_ = &entity_manager_.get_enabled_mask();
+        return system;
+    }
+
+    /**
+     * @brief Calls f(entity) for every enabled entity whose signature holds all of signature's bits, in ID order.
+     *
+     * The query path for types only known at run time, such as runtime
+     * components: intersects the occupancy bitsets of the named pools and
+     * the enabled mask like each_intersection(). f looks components up
+     * itself, e.g. with get_runtime_component().
+     *
+     * @param signature Component types every visited entity has; must not be empty
+     */
+    template<typename F>
+    void each_with(const Signature& signature, F&& f) const {
+        assert(signature.any() && "each_with() needs at least one component type");
+
+        std::array<const EntityMask*, MAX_COMPONENT_TYPES + 1> sets{};
+        std::size_t count = 0;
+        sets[count++] = &entity_manager_.get_enabled_mask();
+        for (ComponentType type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+            if (signature.test(type)) {
+                sets[count] = component_manager_.get_occupancy(type);
+                assert(sets[count] != nullptr && "Component type not registered");
+                ++count;
+            }
+        }
+        EntityMask::for_each_intersection_of({sets.data(), count}, f);
+    }
+
+    /**
+     * @brief Calls f(entity, Ts&...) for every enabled entity having all Ts, in ID order.
+     *
+     * Intersects the pools' occupancy bitsets and the enabled mask a
+     * 64-bit word at a time, skipping 4096-ID regions where any of them
+     * is empty. Unlike view(), the cost follows the matches and the ID
+     * range rather than the size of the first pool, which suits joins of
+     * several sparse types. Const-qualified types are read as in view().
+     *
+     * @tparam Ts The component types every visited entity has
+     */
+    template<typename... Ts, typename F>
+    void each_intersection(F&& f) {
+        [&](auto&... pools) {
+            entity_manager_.get_enabled_mask().for_each_intersection([&](const Entity entity) {
+                f(entity, pools.get(entity)...);
+            }, pools.occupancy()...);
+        }(view_pool<Ts>()...);
     }
 
     /**
@@ -137,17 +562,79 @@ public:
      * 
      * This is a convenience method that automatically creates a signature
      * based on the provided component types and sets it for the specified system.
+     * Besides required types the list may hold Without<...>, for types
+     * matching entities must not have, and Optional<...>, for types the
+     * system uses when present:
+     * set_system_signature<RegenSystem, Health, Without<PlayerControlled>>().
      * 
      * @tparam SystemT The system type
-     * @tparam ComponentTypes The component types required by the system
+     * @tparam Terms The component types required by the system, or terms
      */
-    template<typename SystemT, typename... ComponentTypes>
+    template<typename SystemT, typename... Terms>
     void set_system_signature() noexcept {
-        Signature signature;
-        ((signature.set(component_manager_.get_component_type<ComponentTypes>(), true)), ...);
+        system_manager_.set_filter<SystemT>(make_filter<Terms...>());
+    }
+
+    /**
+     * @brief Sets the signature for a system from a prebuilt bitset.
+     *
+     * Needed when a system requires runtime component types, whose
+     * bits can only be set from their IDs.
+     *
+     * @tparam SystemT The system type
+     * @param signature Component types required by the system
+     */
+    template<typename SystemT>
+    void set_system_signature(const Signature& signature) noexcept {
         system_manager_.set_signature<SystemT>(signature);
     }
 
+    /**
+     * @brief Sets the signature of a system from a prebuilt filter.
+     * @tparam SystemT The system type
+     * @param filter Component types required and excluded by the system
+     */
+    template<typename SystemT>
+    void set_system_signature(const SignatureFilter& filter) noexcept {
+        system_manager_.set_filter<SystemT>(filter);
+    }
+
+    /**
+     * @brief Gets the signature filter of a system.
+     * @return The filter, or nullptr if the system has none
+     */
+    template<typename SystemT>
+    [[nodiscard]] const SignatureFilter* find_system_signature() const noexcept {
+        return system_manager_.find_filter<SystemT>();
+    }
+
+    /**
+     * @brief Declares which components a system reads and writes.
+     *
+     * Schedulers use the declaration to decide which systems may share a
+     * stage. In ECS_ACCESS_AUDIT builds every access the system makes
+     * is checked against it: mutable get_component(), get_component_array()
+     * and view() count as writes, so read-only systems go through a
+     * const World.
+     *
+     * @tparam SystemT The system type
+     * @tparam ReadsT Reads<...> of the components only read
+     * @tparam WritesT Writes<...> of the components read and written
+     */
+    template<typename SystemT, typename ReadsT, typename WritesT = Writes<>>
+    void set_system_access() noexcept {
+        system_manager_.set_access<SystemT>({access_signature(ReadsT{}), access_signature(WritesT{}), typeid(SystemT).name()});
+    }
+
+    /**
+     * @brief Gets the declared component access of a system.
+     * @return The declaration, or nullptr if the system declared none
+     */
+    template<typename SystemT>
+    [[nodiscard]] const SystemAccess* find_system_access() const noexcept {
+        return system_manager_.find_access<SystemT>();
+    }
+
     /**
      * @brief Creates a component signature from the specified component types.
      * 
@@ -165,6 +652,28 @@ public:
         return signature;
     }
 
+    /**
+     * @brief Creates a signature filter from component types and terms.
+     *
+     * Plain types are required, types in Without<...> excluded and types
+     * in Optional<...> recorded as optional.
+     *
+     * @tparam Terms The component types and terms of the filter
+     */
+    template<typename... Terms>
+    [[nodiscard]] SignatureFilter make_filter() const noexcept {
+        SignatureFilter filter;
+        (add_filter_term(filter, std::type_identity<Terms>{}), ...);
+        return filter;
+    }
+
+    /**
+     * @brief Whether an entity matches a signature filter.
+     */
+    [[nodiscard]] bool matches(const Entity entity, const SignatureFilter& filter) const noexcept {
+        return filter.matches(entity_manager_.get_signature(entity));
+    }
+
     /**
       * @brief Gets the current number of active entities.
       * @return Number of active entities
@@ -172,6 +681,66 @@ public:
     [[nodiscard]] std::uint64_t get_entity_count() const noexcept {
         return entity_manager_.get_living_entity_count();
     }
+
+private:
+    template<typename T>
+    [[nodiscard]] auto& view_pool() noexcept {
+        if constexpr (std::is_const_v<T>) {
+            using Component = std::remove_const_t<T>;
+            return published<Component>(*std::as_const(component_manager_).get_component_array<Component>());
+        } else {
+            return *component_manager_.get_component_array<T>();
+        }
+    }
+
+    template<typename T>
+    [[nodiscard]] detail::ViewTerm<T> view_term(std::type_identity<T>) noexcept {
+        return view_pool<T>();
+    }
+
+    template<typename... Ts>
+    [[nodiscard]] detail::ViewTerm<Without<Ts...>> view_term(std::type_identity<Without<Ts...>>) noexcept {
+        return detail::ViewTerm<Without<Ts...>>(view_pool<const Ts>()...);
+    }
+
+    template<typename... Ts>
+    [[nodiscard]] detail::ViewTerm<Optional<Ts...>> view_term(std::type_identity<Optional<Ts...>>) noexcept {
+        return detail::ViewTerm<Optional<Ts...>>(view_pool<Ts>()...);
+    }
+
+    template<typename T>
+    void add_filter_term(SignatureFilter& filter, std::type_identity<T>) const noexcept {
+        filter.include.set(component_manager_.get_component_type<T>());
+    }
+
+    template<typename... Ts>
+    void add_filter_term(SignatureFilter& filter, std::type_identity<Without<Ts...>>) const noexcept {
+        filter.exclude |= make_signature<Ts...>();
+    }
+
+    template<typename... Ts>
+    void add_filter_term(SignatureFilter& filter, std::type_identity<Optional<Ts...>>) const noexcept {
+        filter.optional |= make_signature<Ts...>();
+    }
+
+    template<typename... Ts>
+    [[nodiscard]] Signature access_signature(Reads<Ts...>) const noexcept {
+        return make_signature<Ts...>();
+    }
+
+    template<typename... Ts>
+    [[nodiscard]] Signature access_signature(Writes<Ts...>) const noexcept {
+        return make_signature<Ts...>();
+    }
+
+    void set_signature_bit(const Entity entity, const ComponentType type, const bool value) noexcept {
+        const auto old_signature = entity_manager_.get_signature(entity);
+        auto signature = old_signature;
+        signature.set(type, value);
+
+        entity_manager_.set_signature(entity, signature);
+        system_manager_.entity_signature_changed(entity, old_signature, signature);
+    }
 };
 
 }
@@ -0,0 +1,176 @@
+#ifndef GAME_ECS_WORLD_DIGEST_HPP
+#define GAME_ECS_WORLD_DIGEST_HPP
+
+#include "ecs/cache.hpp"
+#include "ecs/component_manager.hpp"
+#include "ecs/component_storage.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_manager.hpp"
+#include "ecs/hashing.hpp"
+#include "ecs/world.hpp"
+#include "ecs/world_observer.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace game::ecs {
+
+/**
+ * @brief Incrementally maintained, order-independent digest of world state.
+ *
+ * The digest is the wrapping sum of one hash per (entity, component)
+ * pair over all tracked component types. Each pair's last hash is kept,
+ * so adds, removes and marked writes adjust the sum by a delta and
+ * get_digest() is O(1). Two worlds holding the same tracked components
+ * on the same entity IDs produce the same digest regardless of insertion
+ * order or pool layout, which is what lockstep peers compare each tick.
+ *
+ * Writes through mutable get_component() must be reported with
+ * World::mark_component_changed() for the digest to stay correct.
+ * Updates are atomic, so systems running in parallel may mark
+ * different entities concurrently; per-type sums sit on their own cache
+ * lines so systems writing different types do not false-share. Components are hashed byte-wise,
+ * so tracked types should not contain padding.
+ */
+class WorldDigest final : public IWorldObserver {
+    World& world_;
+    std::array<std::uint32_t, MAX_COMPONENT_TYPES> sizes_{};
+    std::array<std::vector<std::uint64_t>, MAX_COMPONENT_TYPES> entity_hashes_{};
+    std::array<CachePadded<std::atomic<std::uint64_t>>, MAX_COMPONENT_TYPES> type_sums_{};
+    CachePadded<std::atomic<std::uint64_t>> digest_{};
+
+public:
+    explicit WorldDigest(World& world) : world_(world) {
+        world_.add_observer(this);
+    }
+
+    WorldDigest(const WorldDigest&) = delete;
+    WorldDigest& operator=(const WorldDigest&) = delete;
+
+    ~WorldDigest() override {
+        world_.remove_observer(this);
+    }
+
+    /**
+     * @brief Adds a component type to the digest, hashing its current pool once.
+     * @tparam T A trivially copyable component type
+     */
+    template<typename T>
+    void track() {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable components can be hashed");
+
+        const auto type = world_.get_component_type<T>();
+        if (sizes_[type] != 0) {
+            return;
+        }
+        sizes_[type] = sizeof(T);
+        entity_hashes_[type].assign(MAX_ENTITIES, 0);
+
+        // Observer hooks hash the values being written, so read the back
+        // buffer of double-buffered pools rather than the published one
+        const auto& pool = latest<T>(std::as_const(world_).get_component_array<T>());
+        if constexpr (ColdStorage<T>::value) {
+            // Hashing must not thaw or stamp cold pages
+            pool.for_each_page([&](const std::size_t first, const std::span<const T> page) {
+                for (std::size_t i = 0; i < page.size(); ++i) {
+                    store(pool.entity_at(first + i), type, &page[i]);
+                }
+            });
+        } else {
+            for (std::size_t i = 0; i < pool.size(); ++i) {
+                store(pool.entity_at(i), type, &pool.at(i));
+            }
+        }
+    }
+
+    /**
+     * @brief Adds a runtime component type to the digest, hashing its current pool once.
+     * @param type ID returned by World::register_runtime_component()
+     */
+    void track_runtime(const ComponentType type) {
+        if (sizes_[type] != 0) {
+            return;
+        }
+
+        const auto& pool = world_.get_runtime_component_array(type);
+        sizes_[type] = pool.get_descriptor().size;
+        entity_hashes_[type].assign(MAX_ENTITIES, 0);
+        for (std::size_t i = 0; i < pool.size(); ++i) {
+            store(pool.entity_at(i), type, pool.data() + i * pool.get_stride());
+        }
+    }
+
+    /**
+     * @brief Digest over every tracked component in the world.
+     */
+    [[nodiscard]] std::uint64_t get_digest() const noexcept {
+        return digest_->load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Digest over a single component type, to narrow down a desync.
+     */
+    template<typename T>
+    [[nodiscard]] std::uint64_t get_component_digest() const noexcept {
+        return get_component_digest(world_.get_component_type<T>());
+    }
+
+    [[nodiscard]] std::uint64_t get_component_digest(const ComponentType type) const noexcept {
+        return type_sums_[type]->load(std::memory_order_relaxed);
+    }
+
+    void entity_destroyed(const Entity entity, const Signature& signature) override {
+        for (ComponentType type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+            if (signature.test(type)) {
+                erase(entity, type);
+            }
+        }
+    }
+
+    void component_added(const Entity entity, const ComponentType type, const void* component) override {
+        store(entity, type, component);
+    }
+
+    void component_removed(const Entity entity, const ComponentType type) override {
+        erase(entity, type);
+    }
+
+    void component_changed(const Entity entity, const ComponentType type, const void* component) override {
+        store(entity, type, component);
+    }
+
+private:
+    void apply_delta(const ComponentType type, const std::uint64_t delta) noexcept {
+        type_sums_[type]->fetch_add(delta, std::memory_order_relaxed);
+        digest_->fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void store(const Entity entity, const ComponentType type, const void* component) noexcept {
+        if (sizes_[type] == 0) {
+            return;
+        }
+
+        const auto hash = mix_hash(hash_bytes(component, sizes_[type]) ^ mix_hash(entity ^ mix_hash(type)));
+        auto& slot = entity_hashes_[type][entity];
+        apply_delta(type, hash - slot);
+        slot = hash;
+    }
+
+    void erase(const Entity entity, const ComponentType type) noexcept {
+        if (sizes_[type] == 0) {
+            return;
+        }
+
+        auto& slot = entity_hashes_[type][entity];
+        apply_delta(type, 0 - slot);
+        slot = 0;
+    }
+};
+
+}
+
+#endif//GAME_ECS_WORLD_DIGEST_HPP
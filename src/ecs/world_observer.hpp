@@ -0,0 +1,41 @@
+#ifndef GAME_ECS_WORLD_OBSERVER_HPP
+#define GAME_ECS_WORLD_OBSERVER_HPP
+
+#include "ecs/component_manager.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_manager.hpp"
+
+namespace game::ecs {
+
+/**
+ * @brief Receives the structural changes made through a World.
+ *
+ * Observers are notified synchronously after each change, from the
+ * thread that made it. Component pointers are only valid for the
+ * duration of the call. All hooks default to no-ops so an observer
+ * only overrides what it cares about.
+ */
+class IWorldObserver {
+public:
+    virtual ~IWorldObserver() = default;
+
+    virtual void entity_created(Entity /*entity*/) {}
+
+    /**
+     * @brief Called before the entity's components are released.
+     * @param signature The components the entity had
+     */
+    virtual void entity_destroyed(Entity /*entity*/, const Signature& /*signature*/) {}
+
+    virtual void component_added(Entity /*entity*/, ComponentType /*type*/, const void* /*component*/) {}
+    virtual void component_removed(Entity /*entity*/, ComponentType /*type*/) {}
+
+    /**
+     * @brief Called when a system marks a component as written.
+     */
+    virtual void component_changed(Entity /*entity*/, ComponentType /*type*/, const void* /*component*/) {}
+};
+
+}
+
+#endif//GAME_ECS_WORLD_OBSERVER_HPP
@@ -0,0 +1,680 @@
+#ifndef GAME_ECS_WRITE_AHEAD_JOURNAL_HPP
+#define GAME_ECS_WRITE_AHEAD_JOURNAL_HPP
+
+#include "ecs/component_manager.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/entity_bitset.hpp"
+#include "ecs/entity_manager.hpp"
+#include "ecs/reflection.hpp"
+#include "ecs/serialization.hpp"
+#include "ecs/world.hpp"
+#include "ecs/world_observer.hpp"
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace game::ecs {
+
+/**
+ * @brief Append-only journal of a World's structural changes.
+ *
+ * Attached as an IWorldObserver, it records entity creation and
+ * destruction plus component adds, removes and marked updates. Records
+ * are appended to an in-memory batch; a background writer flushes the
+ * batch and issues one fdatasync per group, either every commit interval
+ * or as soon as the batch grows past the group commit size.
+ *
+ * Every record is framed by its length and a CRC-32 of its body, so a
+ * torn or zero-filled tail left by a crash is detected rather than
+ * parsed. Recovery restores the last snapshot (e.g. a MappedWorldImage,
+ * which preserves the entity recycling order) and then replays the
+ * journal on top of it; open() cuts the file back to the last record
+ * replay applied before appending. After each successful snapshot call
+ * truncate() so replay only covers changes made since.
+ *
+ * Only components registered with the journal are recorded. Reflected
+ * components are written with serialize_component(), so they may hold
+ * strings, and marked updates of them are journaled as encode_delta()
+ * records against the last value the journal wrote for that entity.
+ * Other components must be trivially copyable and are written whole.
+ * Requires POSIX file APIs.
+ */
+class WriteAheadJournal final : public IWorldObserver {
+    static constexpr std::uint32_t JOURNAL_MAGIC = 0x4C4A4345;  // "ECJL"
+    static constexpr std::uint32_t JOURNAL_VERSION = 3;
+    static constexpr std::int32_t NO_CODEC = -1;
+    static constexpr std::size_t HEADER_SIZE = 2 * sizeof(std::uint32_t);
+    static constexpr std::size_t FRAME_SIZE = 2 * sizeof(std::uint32_t);
+    static constexpr std::size_t RECORD_HEADER_SIZE = sizeof(std::uint8_t) + sizeof(Entity) + sizeof(std::uint32_t);
+
+public:
+    /**
+     * @brief Why replay() stopped.
+     */
+    enum class ReplayStatus {
+        Complete,          ///< Every record was applied
+        NoJournal,         ///< The file is missing or has no valid header
+        TornTail,          ///< Stopped at a truncated, zero-filled or corrupt record
+        UnknownComponent,  ///< A record names a stable ID that is not registered
+        Rejected           ///< A record does not fit the World, e.g. an entity ID mismatch or a dead entity
+    };
+
+    struct ReplayResult {
+        ReplayStatus status{ReplayStatus::NoJournal};
+        std::size_t applied{0};
+        /// Offset just past the last applied record; open() truncates the file here
+        std::uint64_t valid_bytes{0};
+    };
+
+private:
+
+    enum class RecordKind : std::uint8_t {
+        EntityCreated = 1,
+        EntityDestroyed = 2,
+        ComponentAdded = 3,
+        ComponentRemoved = 4,
+        ComponentChanged = 5,  ///< Whole new value
+        ComponentDelta = 6     ///< encode_delta() record against the previous value
+    };
+
+    /**
+     * @brief Last value journaled per entity; the base of delta records.
+     */
+    template<typename T>
+    struct Shadow {
+        std::vector<T> values = std::vector<T>(MAX_ENTITIES);
+        EntityMask known{};
+    };
+
+    /**
+     * @brief Encodes and applies one component type's records.
+     *
+     * Encoders run under the journal mutex, which also guards the shadow.
+     * Decoders return false when the payload does not fit, without
+     * touching the World.
+     */
+    struct ComponentCodec {
+        std::uint32_t stable_id;
+        ComponentType type;
+        std::shared_ptr<void> shadow;
+        void (*encode)(const World&, void*, ComponentType, Entity, const void*, BinaryWriter&);
+        /// Writes a delta or a whole value and returns which, or nullopt if nothing changed
+        std::optional<RecordKind> (*encode_change)(const World&, void*, ComponentType, Entity, const void*, BinaryWriter&);
+        void (*forget)(void*, Entity);
+        bool (*add)(World&, ComponentType, Entity, BinaryReader&);
+        void (*remove)(World&, ComponentType, Entity);
+        bool (*assign)(World&, ComponentType, Entity, BinaryReader&);
+        /// Null for components without reflection, which never write delta records
+        bool (*patch)(World&, ComponentType, Entity, BinaryReader&);
+    };
+
+    World& world_;
+    std::vector<ComponentCodec> codecs_{};
+    std::array<std::int32_t, MAX_COMPONENT_TYPES> codec_by_type_{};
+    std::unordered_map<std::uint32_t, std::size_t> codec_by_stable_id_{};
+
+    std::chrono::milliseconds commit_interval_;
+    std::size_t group_commit_bytes_;
+    std::filesystem::path replayed_path_{};
+    std::uint64_t replayed_bytes_{0};
+    int fd_{-1};
+    std::thread writer_thread_;
+    mutable std::mutex mutex_{};
+    std::condition_variable writer_condition_{};
+    std::condition_variable durable_condition_{};
+    BinaryWriter pending_{};
+    BinaryWriter scratch_{};
+    std::uint64_t appended_records_{0};
+    std::uint64_t durable_records_{0};
+    bool flush_requested_{false};
+    bool stopping_{false};
+    bool write_failed_{false};
+
+public:
+    explicit WriteAheadJournal(World& world,
+                               const std::chrono::milliseconds commit_interval = std::chrono::milliseconds(100),
+                               const std::size_t group_commit_bytes = 1 << 20)
+        : world_(world), commit_interval_(commit_interval), group_commit_bytes_(group_commit_bytes) {
+        codec_by_type_.fill(NO_CODEC);
+    }
+
+    WriteAheadJournal(const WriteAheadJournal&) = delete;
+    WriteAheadJournal& operator=(const WriteAheadJournal&) = delete;
+
+    ~WriteAheadJournal() override {
+        close();
+    }
+
+    /**
+     * @brief Registers a component type to journal.
+     * @tparam T A reflected or trivially copyable component type
+     * @param stable_id ID written to disk; must not change between builds
+     */
+    template<typename T>
+    void register_component(const std::uint32_t stable_id) {
+        static_assert(Reflected<T> || std::is_trivially_copyable_v<T>,
+                      "Journaled components must be reflected or trivially copyable");
+
+        ComponentCodec codec{
+            stable_id,
+            world_.get_component_type<T>(),
+            nullptr,
+            [](const World&, void* shadow, ComponentType, const Entity entity, const void* component, BinaryWriter& out) {
+                const auto& value = *static_cast<const T*>(component);
+                serialize_component(out, value);
+                if constexpr (Reflected<T>) {
+                    auto& state = *static_cast<Shadow<T>*>(shadow);
+                    state.values[entity] = value;
+                    state.known.set(entity);
+                }
+            },
+            [](const World&, void* shadow, ComponentType, const Entity entity, const void* component,
+               BinaryWriter& out) -> std::optional<RecordKind> {
+                const auto& value = *static_cast<const T*>(component);
+                if constexpr (Reflected<T>) {
+                    // Unknown until the journal has written a whole value, e.g. right after replay
+                    auto& state = *static_cast<Shadow<T>*>(shadow);
+                    if (state.known.test(entity)) {
+                        if (!encode_delta(out, state.values[entity], value)) {
+                            return std::nullopt;
+                        }
+                        state.values[entity] = value;
+                        return RecordKind::ComponentDelta;
+                    }
+                    state.values[entity] = value;
+                    state.known.set(entity);
+                }
+                serialize_component(out, value);
+                return RecordKind::ComponentChanged;
+            },
+            [](void* shadow, const Entity entity) {
+                if constexpr (Reflected<T>) {
+                    static_cast<Shadow<T>*>(shadow)->known.reset(entity);
+                }
+            },
+            [](World& world, ComponentType, const Entity entity, BinaryReader& in) {
+                T component{};
+                if (world.has_component<T>(entity) || !deserialize_component(in, component) || in.remaining() != 0) {
+                    return false;
+                }
+                world.add_component(entity, std::move(component));
+                return true;
+            },
+            [](World& world, ComponentType, const Entity entity) {
+                world.remove_component<T>(entity);
+            },
+            [](World& world, ComponentType, const Entity entity, BinaryReader& in) {
+                T component{};
+                if (!world.has_component<T>(entity) || !deserialize_component(in, component) || in.remaining() != 0) {
+                    return false;
+                }
+                world.get_component<T>(entity) = std::move(component);
+                world.mark_component_changed<T>(entity);
+                return true;
+            },
+            nullptr
+        };
+        if constexpr (Reflected<T>) {
+            codec.shadow = std::make_shared<Shadow<T>>();
+            codec.patch = [](World& world, ComponentType, const Entity entity, BinaryReader& in) {
+                if (!world.has_component<T>(entity)) {
+                    return false;
+                }
+                T component = world.get_component<T>(entity);
+                if (!apply_delta(in, component) || in.remaining() != 0) {
+                    return false;
+                }
+                world.get_component<T>(entity) = std::move(component);
+                world.mark_component_changed<T>(entity);
+                return true;
+            };
+        }
+        add_codec(std::move(codec));
+    }
+
+    /**
+     * @brief Registers a runtime component type to journal.
+     * @param type ID returned by World::register_runtime_component()
+     * @param stable_id ID written to disk; must not change between builds
+     */
+    void register_runtime_component(const ComponentType type, const std::uint32_t stable_id) {
+        add_codec(ComponentCodec{
+            stable_id,
+            type,
+            nullptr,
+            [](const World& world, void*, const ComponentType type, Entity, const void* component, BinaryWriter& out) {
+                out.write_bytes(component, world.get_runtime_component_array(type).get_descriptor().size);
+            },
+            [](const World& world, void*, const ComponentType type, Entity, const void* component,
+               BinaryWriter& out) -> std::optional<RecordKind> {
+                out.write_bytes(component, world.get_runtime_component_array(type).get_descriptor().size);
+                return RecordKind::ComponentChanged;
+            },
+            [](void*, Entity) {},
+            [](World& world, const ComponentType type, const Entity entity, BinaryReader& in) {
+                const auto size = world.get_runtime_component_array(type).get_descriptor().size;
+                if (world.has_runtime_component(entity, type) || in.remaining() != size) {
+                    return false;
+                }
+                world.add_runtime_component(entity, type, in.take(size).data());
+                return true;
+            },
+            [](World& world, const ComponentType type, const Entity entity) {
+                world.remove_runtime_component(entity, type);
+            },
+            [](World& world, const ComponentType type, const Entity entity, BinaryReader& in) {
+                const auto size = world.get_runtime_component_array(type).get_descriptor().size;
+                if (!world.has_runtime_component(entity, type) || in.remaining() != size) {
+                    return false;
+                }
+                std::memcpy(world.get_runtime_component(entity, type), in.take(size).data(), size);
+                world.mark_runtime_component_changed(entity, type);
+                return true;
+            },
+            nullptr
+        });
+    }
+
+    /**
+     * @brief Re-applies a journal file to the World.
+     *
+     * Call after restoring the snapshot the journal was started from and
+     * before open(), so replayed changes are not journaled again. Replay
+     * stops at the first record it cannot apply; a torn tail left by a
+     * crash mid-write is expected and reported as TornTail.
+     *
+     * @param path Journal file to replay
+     * @return Why replay stopped, how many records were applied and where
+     */
+    ReplayResult replay(const std::filesystem::path& path) {
+        assert(fd_ < 0 && "Replay must happen before the journal is opened");
+
+        const auto result = scan(path, true);
+        replayed_path_ = path;
+        replayed_bytes_ = result.valid_bytes;
+        return result;
+    }
+
+    /**
+     * @brief Opens the journal for appending and starts observing the World.
+     *
+     * The file is first truncated to the end of the last valid record:
+     * where replay() of the same path stopped, or else past the last
+     * intact frame. New records therefore never follow a torn one.
+     *
+     * @param path Journal file; created if missing
+     * @return True if the file could be opened
+     */
+    bool open(const std::filesystem::path& path) {
+        assert(fd_ < 0 && "Journal is already open");
+
+        const auto valid_bytes = path == replayed_path_ ? replayed_bytes_ : scan(path, false).valid_bytes;
+
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd_ < 0) {
+            return false;
+        }
+
+        const auto end = ::lseek(fd_, 0, SEEK_END);
+        if (end < 0 || (static_cast<std::uint64_t>(end) > valid_bytes
+                        && (::ftruncate(fd_, static_cast<off_t>(valid_bytes)) != 0 || ::fdatasync(fd_) != 0))) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+
+        if (valid_bytes == 0) {
+            BinaryWriter header;
+            header.write(JOURNAL_MAGIC);
+            header.write(JOURNAL_VERSION);
+            if (!write_all(header.bytes()) || ::fdatasync(fd_) != 0) {
+                ::close(fd_);
+                fd_ = -1;
+                return false;
+            }
+        }
+
+        replayed_path_.clear();
+        stopping_ = false;
+        writer_thread_ = std::thread([this] { writer_loop(); });
+        world_.add_observer(this);
+        return true;
+    }
+
+    /**
+     * @brief Stops observing, flushes outstanding records and closes the file.
+     */
+    void close() {
+        if (fd_ < 0) {
+            return;
+        }
+
+        world_.remove_observer(this);
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        writer_condition_.notify_one();
+        writer_thread_.join();
+
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    /**
+     * @brief Blocks until every record appended so far is durable.
+     * @return False if a write to the journal failed
+     */
+    bool flush() {
+        std::unique_lock lock(mutex_);
+        const auto target = appended_records_;
+        flush_requested_ = true;
+        writer_condition_.notify_one();
+        durable_condition_.wait(lock, [&] { return durable_records_ >= target || write_failed_; });
+        return !write_failed_;
+    }
+
+    /**
+     * @brief Drops all records once a snapshot covering them is durable.
+     * @return False if the journal could not be truncated
+     */
+    bool truncate() {
+        if (!flush()) {
+            return false;
+        }
+
+        std::lock_guard lock(mutex_);
+        return ::ftruncate(fd_, static_cast<off_t>(HEADER_SIZE)) == 0 && ::fdatasync(fd_) == 0;
+    }
+
+    [[nodiscard]] std::uint64_t get_durable_record_count() const noexcept {
+        std::lock_guard lock(mutex_);
+        return durable_records_;
+    }
+
+    void entity_created(const Entity entity) override {
+        std::unique_lock lock(mutex_);
+        append(lock, RecordKind::EntityCreated, entity, 0, {});
+    }
+
+    void entity_destroyed(const Entity entity, const Signature& signature) override {
+        std::unique_lock lock(mutex_);
+        for (const auto& codec : codecs_) {
+            if (signature.test(codec.type)) {
+                codec.forget(codec.shadow.get(), entity);
+            }
+        }
+        append(lock, RecordKind::EntityDestroyed, entity, 0, {});
+    }
+
+    void component_added(const Entity entity, const ComponentType type, const void* component) override {
+        if (const auto* codec = find_codec(type)) {
+            std::unique_lock lock(mutex_);
+            scratch_.clear();
+            codec->encode(world_, codec->shadow.get(), type, entity, component, scratch_);
+            append(lock, RecordKind::ComponentAdded, entity, codec->stable_id, scratch_.bytes());
+        }
+    }
+
+    void component_removed(const Entity entity, const ComponentType type) override {
+        if (const auto* codec = find_codec(type)) {
+            std::unique_lock lock(mutex_);
+            codec->forget(codec->shadow.get(), entity);
+            append(lock, RecordKind::ComponentRemoved, entity, codec->stable_id, {});
+        }
+    }
+
+    void component_changed(const Entity entity, const ComponentType type, const void* component) override {
+        if (const auto* codec = find_codec(type)) {
+            std::unique_lock lock(mutex_);
+            scratch_.clear();
+            if (const auto kind = codec->encode_change(world_, codec->shadow.get(), type, entity, component, scratch_)) {
+                append(lock, *kind, entity, codec->stable_id, scratch_.bytes());
+            }
+        }
+    }
+
+private:
+    void add_codec(ComponentCodec codec) {
+        assert(!codec_by_stable_id_.contains(codec.stable_id) && "Stable ID already registered");
+        codec_by_type_[codec.type] = static_cast<std::int32_t>(codecs_.size());
+        codec_by_stable_id_[codec.stable_id] = codecs_.size();
+        codecs_.push_back(std::move(codec));
+    }
+
+    [[nodiscard]] const ComponentCodec* find_codec(const ComponentType type) const noexcept {
+        const auto index = codec_by_type_[type];
+        return index == NO_CODEC ? nullptr : &codecs_[static_cast<std::size_t>(index)];
+    }
+
+    /**
+     * @brief Frames a record into the pending batch. Called with mutex_ held.
+     */
+    void append(std::unique_lock<std::mutex>& lock, const RecordKind kind, const Entity entity,
+                const std::uint32_t stable_id, const std::span<const std::byte> payload) {
+        std::byte body[RECORD_HEADER_SIZE];
+        std::memcpy(body, &kind, sizeof(kind));
+        std::memcpy(body + sizeof(kind), &entity, sizeof(entity));
+        std::memcpy(body + sizeof(kind) + sizeof(entity), &stable_id, sizeof(stable_id));
+
+        const auto length = static_cast<std::uint32_t>(RECORD_HEADER_SIZE + payload.size());
+        auto crc = crc32_update(CRC_INITIAL, body, RECORD_HEADER_SIZE);
+        crc = ~crc32_update(crc, payload.data(), payload.size());
+
+        pending_.write(length);
+        pending_.write(crc);
+        pending_.write_bytes(body, RECORD_HEADER_SIZE);
+        if (!payload.empty()) {
+            pending_.write_bytes(payload.data(), payload.size());
+        }
+        ++appended_records_;
+
+        if (pending_.size() >= group_commit_bytes_) {
+            lock.unlock();
+            writer_condition_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Walks the records of a journal file, applying them if asked.
+     *
+     * Without apply only the framing is checked, which is what open()
+     * needs when no replay of the file preceded it.
+     */
+    ReplayResult scan(const std::filesystem::path& path, const bool apply_records) {
+        ReplayResult result;
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return result;
+        }
+        std::vector<std::byte> bytes(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+        BinaryReader reader(bytes);
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        reader.read(magic);
+        reader.read(version);
+        if (!file || !reader.ok() || magic != JOURNAL_MAGIC || version != JOURNAL_VERSION) {
+            return result;
+        }
+
+        result.status = ReplayStatus::Complete;
+        result.valid_bytes = HEADER_SIZE;
+        while (reader.remaining() > 0) {
+            std::uint32_t length = 0;
+            std::uint32_t crc = 0;
+            reader.read(length);
+            reader.read(crc);
+            const auto body = reader.take(length);
+            // A zero-filled tail fails here: no record is shorter than its header
+            if (!reader.ok() || length < RECORD_HEADER_SIZE
+                || crc != ~crc32_update(CRC_INITIAL, body.data(), body.size())) {
+                result.status = ReplayStatus::TornTail;
+                break;
+            }
+
+            if (apply_records) {
+                RecordKind kind{};
+                Entity entity = INVALID_ENTITY;
+                std::uint32_t stable_id = 0;
+                std::memcpy(&kind, body.data(), sizeof(kind));
+                std::memcpy(&entity, body.data() + sizeof(kind), sizeof(entity));
+                std::memcpy(&stable_id, body.data() + sizeof(kind) + sizeof(entity), sizeof(stable_id));
+
+                const auto status = apply(kind, entity, stable_id, body.subspan(RECORD_HEADER_SIZE));
+                if (status != ReplayStatus::Complete) {
+                    result.status = status;
+                    break;
+                }
+                ++result.applied;
+            }
+            result.valid_bytes += FRAME_SIZE + length;
+        }
+        return result;
+    }
+
+    ReplayStatus apply(const RecordKind kind, const Entity entity, const std::uint32_t stable_id,
+                       const std::span<const std::byte> payload) {
+        switch (kind) {
+            case RecordKind::EntityCreated:
+                // Holds as long as the snapshot preserved the recycling order
+                return world_.add_entity() == entity ? ReplayStatus::Complete : ReplayStatus::Rejected;
+            case RecordKind::EntityDestroyed:
+                // Removing a dead ID would queue it for reuse a second time
+                if (!world_.is_entity_alive(entity)) {
+                    return ReplayStatus::Rejected;
+                }
+                world_.remove_entity(entity);
+                return ReplayStatus::Complete;
+            case RecordKind::ComponentAdded:
+            case RecordKind::ComponentRemoved:
+            case RecordKind::ComponentChanged:
+            case RecordKind::ComponentDelta:
+                break;
+            default:
+                return ReplayStatus::Rejected;
+        }
+
+        const auto it = codec_by_stable_id_.find(stable_id);
+        if (it == codec_by_stable_id_.end()) {
+            return ReplayStatus::UnknownComponent;
+        }
+
+        const auto& codec = codecs_[it->second];
+        if (!world_.is_entity_alive(entity)) {
+            return ReplayStatus::Rejected;
+        }
+        if (kind == RecordKind::ComponentRemoved) {
+            if (!world_.get_signature(entity).test(codec.type)) {
+                return ReplayStatus::Rejected;
+            }
+            codec.remove(world_, codec.type, entity);
+            return ReplayStatus::Complete;
+        }
+
+        BinaryReader reader(payload);
+        bool applied = false;
+        if (kind == RecordKind::ComponentAdded) {
+            applied = codec.add(world_, codec.type, entity, reader);
+        } else if (kind == RecordKind::ComponentChanged) {
+            applied = codec.assign(world_, codec.type, entity, reader);
+        } else {
+            applied = codec.patch != nullptr && codec.patch(world_, codec.type, entity, reader);
+        }
+        return applied ? ReplayStatus::Complete : ReplayStatus::Rejected;
+    }
+
+    void writer_loop() {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            writer_condition_.wait_for(lock, commit_interval_, [this] {
+                return stopping_ || flush_requested_ || pending_.size() >= group_commit_bytes_;
+            });
+
+            if (pending_.size() == 0) {
+                flush_requested_ = false;
+                durable_condition_.notify_all();
+                if (stopping_) {
+                    return;
+                }
+                continue;
+            }
+
+            // Take the whole group and commit it with a single sync
+            const auto batch = pending_.release();
+            pending_ = BinaryWriter{};
+            const auto batch_records = appended_records_;
+            flush_requested_ = false;
+            lock.unlock();
+
+            const bool ok = write_all(batch) && ::fdatasync(fd_) == 0;
+
+            lock.lock();
+            if (ok) {
+                durable_records_ = batch_records;
+            } else {
+                write_failed_ = true;
+            }
+            durable_condition_.notify_all();
+        }
+    }
+
+    bool write_all(const std::vector<std::byte>& bytes) const noexcept {
+        std::size_t written = 0;
+        while (written < bytes.size()) {
+            const auto result = ::write(fd_, bytes.data() + written, bytes.size() - written);
+            if (result <= 0) {
+                return false;
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        return true;
+    }
+
+    static constexpr std::uint32_t CRC_INITIAL = 0xFFFFFFFFu;
+
+    /**
+     * @brief Reflected CRC-32 (IEEE 802.3) lookup table.
+     */
+    static constexpr std::array<std::uint32_t, 256> CRC_TABLE = [] {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            auto crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1u) != 0 ? 0xEDB88320u : 0u);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    [[nodiscard]] static std::uint32_t crc32_update(std::uint32_t crc, const void* data, const std::size_t size) noexcept {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            crc = CRC_TABLE[(crc ^ bytes[i]) & 0xFFu] ^ (crc >> 8);
+        }
+        return crc;
+    }
+};
+
+}
+
+#endif//GAME_ECS_WRITE_AHEAD_JOURNAL_HPP